@@ -0,0 +1,84 @@
+// bench/bench.cpp
+#include "bench.h"
+#include "memstats.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Allocations: contadores de memstats, que solo avanzan con los hooks de operator new (allochooks.cpp)
+uint64_t benchAllocCount() { return allocCounters().allocs; }
+uint64_t benchAllocBytes() { return allocCounters().bytesAllocated; }
+
+BenchRunner::BenchRunner(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "--filter") == 0) filter = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0) jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0) minTimeMs = atof(argv[++i]);
+    }
+    if (!allocHooksInstalled()) {
+        std::cerr << "Sin hooks de allocations (GAME_ALLOC_HOOKS=OFF): allocs/op y bytes/op salen en 0" << std::endl;
+    }
+}
+
+bool BenchRunner::enabled(const std::string& prefix) const {
+    // Grupo activo si el filtro matchea el prefijo o es más específico que él ("ecs/get" activa "ecs/")
+    return filter.empty() || prefix.find(filter) != std::string::npos || filter.find(prefix) != std::string::npos;
+}
+
+void BenchRunner::run(const std::string& name, size_t items, const std::function<void()>& op) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+    using Clock = std::chrono::steady_clock;
+
+    op();  // Warmup (caches, reservas de buffers estáticos)
+
+    size_t iterations = 0;
+    uint64_t allocs0 = benchAllocCount(), bytes0 = benchAllocBytes();
+    auto start = Clock::now();
+    double elapsedMs = 0.0;
+    while (iterations < 3 || elapsedMs < minTimeMs) {
+        op();
+        ++iterations;
+        elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    BenchResult r;
+    r.name = name;
+    r.items = items;
+    r.iterations = iterations;
+    r.nsPerOp = elapsedMs * 1e6 / iterations;
+    r.nsPerItem = r.nsPerOp / (items ? items : 1);
+    r.itemsPerSec = r.nsPerOp > 0.0 ? items * 1e9 / r.nsPerOp : 0.0;
+    r.allocsPerOp = (double)(benchAllocCount() - allocs0) / iterations;
+    r.bytesPerOp = (double)(benchAllocBytes() - bytes0) / iterations;
+    results.push_back(r);
+
+    printf("%-40s %12.0f ns/op %10.2f ns/item %14.0f items/s %10.1f allocs/op\n",
+           r.name.c_str(), r.nsPerOp, r.nsPerItem, r.itemsPerSec, r.allocsPerOp);
+    fflush(stdout);
+}
+
+void BenchRunner::report() const {
+    std::cout << results.size() << " benchmarks" << std::endl;
+    if (!jsonPath.empty()) writeJson();
+}
+
+void BenchRunner::writeJson() const {
+    FILE* f = fopen(jsonPath.c_str(), "w");
+    if (!f) {
+        std::cerr << "Error: no se pudo escribir " << jsonPath << std::endl;
+        return;
+    }
+    fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"items\": %zu, \"iterations\": %zu, \"ns_per_op\": %.3f, "
+                   "\"ns_per_item\": %.4f, \"items_per_sec\": %.1f, \"allocs_per_op\": %.2f, \"bytes_per_op\": %.1f}%s\n",
+                r.name.c_str(), r.items, r.iterations, r.nsPerOp, r.nsPerItem, r.itemsPerSec,
+                r.allocsPerOp, r.bytesPerOp, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    std::cout << "JSON: " << jsonPath << std::endl;
+}
@@ -0,0 +1,52 @@
+// bench/bench.h
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+// Mini harness de microbenchmarks: ns/op, items/s y allocations por op (operator new de src/allochooks.cpp,
+// compilado en GAME_bench con GAME_ALLOC_HOOKS=ON; sin hooks las allocations salen en 0 y se avisa).
+// Cada caso corre hasta minTimeMs (mín. 3 iteraciones) después de 1 iteración de warmup.
+
+struct BenchResult {
+    std::string name;
+    size_t items = 1;         // Items procesados por op (entities, samples, tiles...)
+    size_t iterations = 0;
+    double nsPerOp = 0.0;
+    double nsPerItem = 0.0;
+    double itemsPerSec = 0.0;
+    double allocsPerOp = 0.0;
+    double bytesPerOp = 0.0;
+};
+
+// Contadores globales (memstats, alimentados por los hooks de allochooks.cpp)
+uint64_t benchAllocCount();
+uint64_t benchAllocBytes();
+
+class BenchRunner {
+public:
+    BenchRunner(int argc, char** argv);  // --filter SUBSTR, --json PATH, --min-time MS
+
+    // op() procesa `items` items; se cronometra completa. Los casos filtrados ni se preparan
+    void run(const std::string& name, size_t items, const std::function<void()>& op);
+    bool enabled(const std::string& prefix) const;  // Para saltar el setup de grupos filtrados
+
+    void report() const;  // Tabla por stdout + JSON si se pidió
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+private:
+    std::string filter;
+    std::string jsonPath;
+    double minTimeMs = 200.0;
+    std::vector<BenchResult> results;
+
+    void writeJson() const;
+};
+
+// Evita que el compilador elimine resultados no usados
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
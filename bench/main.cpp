@@ -0,0 +1,360 @@
+// bench/main.cpp
+#include "bench.h"
+#include "ecs.h"
+#include "components.h"
+#include "systems.h"
+#include "perlin.h"
+#include "spatial.h"
+#include "collision.h"
+#include "platform.h"
+#include "breakout.h"
+#include "aibatch.h"
+#include "renderqueue.h"
+#include "chunksummary.h"
+#include "flowfield.h"
+#include "replay.h"
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+// Mapa procedural width x height (en chunks de 20) ya autotileado
+static TileMap makeTileMap(int chunksX, int chunksY, unsigned int seed = 12345) {
+    TileMap tm;
+    tm.width = tm.chunkSize * chunksX;
+    tm.height = tm.chunkSize * chunksY;
+    tm.maxWidth = tm.width;
+    tm.maxHeight = tm.height;
+    tm.tiles.resize(tm.width * tm.height);
+    PerlinNoise perlin(seed);
+    ChunkGenParams params;
+    for (int cy = 0; cy < chunksY; ++cy)
+        for (int cx = 0; cx < chunksX; ++cx) generateChunkTiles(tm, cx, cy, perlin, params);
+    return tm;
+}
+
+// Entities dentro del mapa sobre tiles caminables; con Size para el collider de systemMovement. Con pattern
+// llevan Animation como los enemies (la AI escribe el estado cada tick)
+static void spawnMovers(ECS& ecs, const TileMap& tm, size_t count, bool withPattern) {
+    const float tileWorld = tm.tileSize * tm.scale;
+    Entity player = ecs.createEntity();
+    ecs.addComponent(player, Position{{tm.width * tileWorld / 2, tm.height * tileWorld / 2}});
+    ecs.addComponent(player, InputControlled{});
+
+    size_t tile = 0;
+    for (size_t i = 0; i < count; ++i) {
+        while (tm.tiles[tile % tm.tiles.size()].value == IntGridValue::NON_WALKABLE) ++tile;
+        int idx = (int)(tile % tm.tiles.size());
+        tile += 7;  // Reparte por el mapa
+        Vector2 p = {(idx % tm.width) * tileWorld + 8, (idx / tm.width) * tileWorld + 8};
+
+        Entity e = ecs.createEntity();
+        ecs.addComponent(e, Position{p});
+        ecs.addComponent(e, Velocity{{(float)((int)(i % 7) - 3) * 40.0f, (float)((int)(i % 5) - 2) * 40.0f}});
+        ecs.addComponent(e, Size{48.0f, 48.0f});
+        if (!withPattern) continue;
+
+        MovementPattern pat;
+        pat.target = player;
+        switch (i % 3) {
+            case 0: pat.setTracking(); pat.speed = 150.0f; pat.tracking.pursuitDistance = 0.0f; break;
+            case 1: pat.setCircular(); pat.circular.center = p; pat.circular.radius = 100.0f; break;
+            default: {
+                pat.setPatrol();
+                PatrolRoute route;
+                route.points = {p, {p.x + 128, p.y}, {p.x + 128, p.y + 128}};
+                syncPatrolRoute(pat, route);
+                ecs.addComponent(e, std::move(route));
+                break;
+            }
+        }
+        ecs.addComponent(e, pat);
+        ecs.addComponent(e, Animation{});
+    }
+}
+
+static void benchEcs(BenchRunner& bench) {
+    const size_t n = 10000;
+    ECS ecs;
+
+    if (bench.enabled("ecs/")) {
+        bench.run("ecs/add_remove Position", n, [&] {
+            Entity first = ecs.createEntities(n);
+            for (size_t i = 0; i < n; ++i) ecs.addComponent(first + i, Position{{(float)i, 0}});
+            for (size_t i = 0; i < n; ++i) ecs.removeComponent<Position>(first + i);
+        });
+
+        Entity first = ecs.createEntities(n);
+        for (size_t i = 0; i < n; ++i) {
+            ecs.addComponent(first + i, Position{{(float)i, 0}});
+            ecs.addComponent(first + i, Velocity{{1, 1}});
+        }
+        bench.run("ecs/get Position", n, [&] {
+            float sum = 0;
+            for (size_t i = 0; i < n; ++i) sum += ecs.getComponent<Position>(first + i)->pos.x;
+            doNotOptimize(sum);
+        });
+        bench.run("ecs/iterate Position+Velocity", n, [&] {
+            for (auto& [e, pos] : ecs.getComponentMap<Position>()) {
+                if (auto* vel = ecs.getComponent<Velocity>(e)) {
+                    pos.pos.x += vel->vel.x * 0.001f;
+                    pos.pos.y += vel->vel.y * 0.001f;
+                }
+            }
+        });
+        bench.run("ecs/removeEntity", n, [&] {
+            for (size_t i = 0; i < n; ++i) ecs.removeEntity(first + i);
+            for (size_t i = 0; i < n; ++i) {
+                ecs.addComponent(first + i, Position{{(float)i, 0}});
+                ecs.addComponent(first + i, Velocity{{1, 1}});
+            }
+        });
+    }
+}
+
+static void benchSystems(BenchRunner& bench) {
+    for (size_t n : {1000, 10000, 50000}) {
+        std::string suffix = "/" + std::to_string(n);
+        if (bench.enabled("systemMovement" + suffix)) {
+            ECS ecs;
+            Entity mapEnt = ecs.createEntity();
+            ecs.addComponent(mapEnt, makeTileMap(10, 10));
+            spawnMovers(ecs, *ecs.getComponent<TileMap>(mapEnt), n, false);
+            bench.run("systemMovement" + suffix, n, [&] { systemMovement(ecs, 1.0f / 60.0f); });
+        }
+        if (bench.enabled("systemAI" + suffix)) {
+            ECS ecs;
+            Entity mapEnt = ecs.createEntity();
+            ecs.addComponent(mapEnt, makeTileMap(10, 10));
+            spawnMovers(ecs, *ecs.getComponent<TileMap>(mapEnt), n, true);
+            bench.run("systemAI" + suffix, n, [&] { systemAI(ecs, 1.0f / 60.0f); });
+        }
+        if (bench.enabled("systemAI batched" + suffix)) {
+            // Mismo mundo que systemAI/N: entities/ms = items/s / 1000, comparables entre los dos casos
+            ECS ecs;
+            Entity mapEnt = ecs.createEntity();
+            ecs.addComponent(mapEnt, makeTileMap(10, 10));
+            spawnMovers(ecs, *ecs.getComponent<TileMap>(mapEnt), n, true);
+            AIBatch batch;
+            bench.run("systemAI batched" + suffix, n, [&] { systemAI(ecs, 1.0f / 60.0f, nullptr, &batch); });
+        }
+    }
+}
+
+static void benchWorldGen(BenchRunner& bench) {
+    if (bench.enabled("perlin/")) {
+        PerlinNoise perlin(12345);
+        const size_t samples = 100000;
+        bench.run("perlin/noise", samples, [&] {
+            double sum = 0.0;
+            for (size_t i = 0; i < samples; ++i) sum += perlin.noise((i % 317) * 0.03, (i / 317) * 0.03);
+            doNotOptimize(sum);
+        });
+    }
+
+    if (bench.enabled("worldgen/chunk")) {
+        TileMap tm;
+        tm.width = tm.height = tm.chunkSize;
+        tm.tiles.resize(tm.width * tm.height);
+        // Noise armado fuera de la medición (la tabla de permutación no es parte de generar un chunk)
+        std::vector<PerlinNoise> seeds;
+        for (unsigned int i = 0; i < 16; ++i) seeds.emplace_back(12345 + i);
+        ChunkGenParams params;
+        size_t chunk = 0;
+        bench.run("worldgen/chunk 20x20", tm.tiles.size(), [&] {
+            // Offset 0 para escribir siempre el mismo buffer; el ruido varía con el seed del chunk
+            generateChunkTiles(tm, 0, 0, seeds[chunk++ % seeds.size()], params);
+        });
+    }
+
+    if (bench.enabled("worldgen/autotile")) {
+        ECS ecs;
+        Entity mapEnt = ecs.createEntity();
+        ecs.addComponent(mapEnt, makeTileMap(10, 10));
+        const size_t tiles = ecs.getComponent<TileMap>(mapEnt)->tiles.size();
+        bench.run("worldgen/autotile 200x200", tiles, [&] { systemAutoTiling(ecs); });
+        bench.run("worldgen/autotileChunk 20x20", 22 * 22, [&] { systemAutoTilingChunk(ecs, 79, 79, 100, 100); });
+    }
+}
+
+static void benchCollision(BenchRunner& bench) {
+    const size_t n = 10000;
+
+    if (bench.enabled("collision/sweepAABB")) {
+        std::vector<Rectangle> boxes(n);
+        for (size_t i = 0; i < n; ++i) boxes[i] = {(float)(i % 100) * 20.0f, (float)(i / 100) * 20.0f, 16, 16};
+        bench.run("collision/sweepAABB", n, [&] {
+            int hits = 0;
+            Rectangle mover = {500, 500, 15, 15};
+            for (size_t i = 0; i < n; ++i) hits += sweepAABB(mover, {300, -200}, boxes[i]).hit;
+            doNotOptimize(hits);
+        });
+    }
+
+    if (bench.enabled("collision/sweepMany")) {
+        TileMap tm = makeTileMap(10, 10);
+        std::vector<SweepBody> bodies(n);
+        for (size_t i = 0; i < n; ++i) {
+            bodies[i].box = {(float)(i % 100) * 120.0f + 10, (float)(i / 100) * 120.0f + 10, 32, 32};
+            bodies[i].delta = {(float)((int)(i % 9) - 4) * 6.0f, (float)((int)(i % 7) - 3) * 6.0f};
+        }
+        std::vector<TileSweep> out;
+        bench.run("collision/sweepMany tiles", n, [&] { sweepMany(tm, bodies, out); });
+    }
+
+    if (bench.enabled("collision/grid")) {
+        SpatialGrid grid(64.0f, 16384);
+        std::vector<Rectangle> boxes(n);
+        for (size_t i = 0; i < n; ++i) boxes[i] = {(float)((i * 7919) % 4000), (float)((i * 104729) % 4000), 24, 24};
+        std::vector<std::pair<Entity, Entity>> pairs;
+        bench.run("collision/grid rebuild+pairs", n, [&] {
+            grid.clear();
+            for (size_t i = 0; i < n; ++i) grid.insert(i, boxes[i]);
+            grid.build();
+            grid.queryPairs(pairs);
+            doNotOptimize(pairs.size());
+        });
+    }
+
+    if (bench.enabled("collision/breakout")) {
+        // Mismo layout que assets/levels/breakout_stress.txt: 100x100 bloques, 1000 balls
+        BlockGrid grid;
+        grid.resize(100, 100);
+        grid.cellW = 8.0f;
+        grid.cellH = 4.0f;
+        grid.origin = {0, 40};
+        for (int y = 0; y < 100; ++y)
+            for (int x = 0; x < 100; ++x)
+                if ((x / 10 + y / 10) % 4 != 3) grid.set(x, y, (uint8_t)(1 + (99 - y) / 25));
+        BallSet balls;
+        spawnBalls(balls, 1000, 4.0f, 240.0f, 500.0f, 800);
+        // Avanza un rato para que las balls estén repartidas entre los bloques, y mide desde ese estado
+        Rectangle paddle = {0, 560, 800, 20};  // Paddle de lado a lado: no se pierden balls
+        for (int i = 0; i < 120; ++i) stepBalls(balls, grid, paddle, 1.0f / 60.0f, 800, 600);
+        BlockGrid gridCopy;
+        BallSet ballsCopy;
+        bench.run("collision/breakout 1000 balls 100x100 grid", balls.count(), [&] {
+            gridCopy = grid;  // Copias sin realloc (mismo tamaño): el paso no consume el estado base
+            ballsCopy = balls;
+            doNotOptimize(stepBalls(ballsCopy, gridCopy, paddle, 1.0f / 60.0f, 800, 600).hits);
+        });
+    }
+}
+
+static void benchRender(BenchRunner& bench) {
+    // Sin GL: generación de comandos + merge + radix sort (el replay necesita ventana)
+    const size_t n = 100000;
+    if (bench.enabled("renderqueue/")) {
+        Texture2D textures[4] = {};
+        for (uint32_t t = 0; t < 4; ++t) textures[t] = {t + 1, 1024, 1024, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+        auto submit = [&](CommandBuffer& out, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Rectangle dst = {(float)(i % 400) * 16.0f, (float)(i / 400) * 16.0f, 16, 16};
+                if (i % 5 == 0) out.quad(RenderLayer::Sprites, textures[i % 4], {0, 0, 16, 16}, dst, WHITE, depthFromY(dst.y + dst.height));  // Como submitSprite
+                else out.quad(RenderLayer::Tiles, textures[i % 4], {0, 0, 16, 16}, dst, WHITE);
+            }
+        };
+        RenderQueue queue;
+        bench.run("renderqueue/submit+sort serial", n, [&] {
+            queue.beginFrame();
+            submit(queue.main(), 0, n);
+            queue.sort();
+        });
+        bench.run("renderqueue/submit+sort parallel", n, [&] {
+            queue.beginFrame();
+            queue.parallelFor(n, 2048, submit);
+            queue.sort();
+        });
+    }
+
+    if (bench.enabled("chunksummary/")) {
+        // Headless: sin readback, samples planos por IntGridValue (mide el armado de niveles, no el sampleo)
+        TileMap tm = makeTileMap(10, 10);
+        ChunkSummaries summaries;
+        const size_t chunks = 10 * 10;
+        bench.run("chunksummary/rebuild 10x10 chunks", chunks, [&] {
+            summaries.clear();
+            summaries.sync(tm, false);
+        });
+        bench.run("chunksummary/resync 1 chunk", 1, [&] {
+            tm.tiles[0].value = tm.tiles[0].value == IntGridValue::HAZARD ? IntGridValue::WALKABLE : IntGridValue::HAZARD;
+            tm.revision++;
+            summaries.sync(tm, false);
+        });
+        RenderQueue queue;
+        const float world = tm.width * tm.tileSize * tm.scale;
+        bench.run("chunksummary/submit level 3", chunks, [&] {
+            queue.beginFrame();
+            summaries.submit(tm, queue.main(), {0, 0, world, world}, ChunkSummaries::kLevels);
+        });
+    }
+}
+
+// --check: systemAI batched (kernels SSE2) contra updateMovementPattern escalar sobre el mismo mundo y seed.
+// Tienen que quedar bit a bit iguales: los replays dependen de eso (ver simdmath.h)
+static bool checkAIBatchParity() {
+    const size_t n = 5000;
+    const int ticks = 600;
+    const float dt = 1.0f / 60.0f;
+    setDeterministic(true);  // Flow field calculado en el acto: los dos mundos ven el mismo field
+    ECS scalar, batched;
+    for (ECS* ecs : {&scalar, &batched}) {
+        Entity mapEnt = ecs->createEntity();
+        ecs->addComponent(mapEnt, makeTileMap(10, 10));
+        spawnMovers(*ecs, *ecs->getComponent<TileMap>(mapEnt), n, true);
+    }
+    FlowField flow;
+    const TileMap& tm = *scalar.getComponent<TileMap>(0);
+    flow.requestIfChanged(tm, scalar.getComponent<Position>(1)->pos);  // Entity 1 = player (spawnMovers)
+    AIBatch batch;
+
+    int firstBadTick = -1;
+    size_t differing = 0;
+    for (int tick = 0; tick < ticks && firstBadTick < 0; ++tick) {
+        systemAI(scalar, dt, &flow);
+        systemAI(batched, dt, &flow, &batch);
+        systemMovement(scalar, dt);
+        systemMovement(batched, dt);
+        for (auto& [entity, pos] : scalar.getComponentMap<Position>()) {
+            const Position* other = batched.getComponent<Position>(entity);
+            const Velocity* va = scalar.getComponent<Velocity>(entity);
+            const Velocity* vb = batched.getComponent<Velocity>(entity);
+            const Animation* aa = scalar.getComponent<Animation>(entity);
+            const Animation* ab = batched.getComponent<Animation>(entity);
+            bool same = other && std::memcmp(&pos.pos, &other->pos, sizeof(Vector2)) == 0;
+            if (same && va && vb) same = std::memcmp(&va->vel, &vb->vel, sizeof(Vector2)) == 0;
+            if (same && aa && ab) same = aa->currentState == ab->currentState;
+            if (!same) {
+                ++differing;
+                firstBadTick = tick;
+            }
+        }
+    }
+    setDeterministic(false);
+    if (firstBadTick >= 0) {
+        printf("ai batch parity: FAIL, %zu entities differ at tick %d\n", differing, firstBadTick);
+        return false;
+    }
+    printf("ai batch parity: OK (%zu entities, %d ticks, bit-identical)\n", n, ticks);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    setHeadless(true);  // Nada de GL: loadTexture/input en modo stub
+    SetTraceLogLevel(LOG_WARNING);
+    SetRandomSeed(12345);
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--check") == 0) return checkAIBatchParity() ? 0 : 1;
+    }
+
+    BenchRunner bench(argc, argv);
+    benchEcs(bench);
+    benchSystems(bench);
+    benchWorldGen(bench);
+    benchCollision(bench);
+    benchRender(bench);
+    bench.report();
+    return 0;
+}
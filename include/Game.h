@@ -2,10 +2,16 @@
 #pragma once
 #include <raylib.h>
 #include <memory>
+#include <functional>
+#include <thread>
 #include "Scene.h"
 #include "scenes/BreakoutScene.h"
 #include "scenes/MenuScene.h"
 #include "editor/Editor.h"
+#include "replay.h"
+#include "platform.h"
+#include "debugoverlay.h"
+#include "renderqueue.h"
 #include "scenes/AdventureScene.h"
 
 class Game {
@@ -22,6 +28,20 @@ public:
     void clean();
     bool running();
 
+    // Fixed timestep: la simulación avanza en ticks de 1/tickRate; render interpola entre ticks
+    void setTickRate(float hz);
+    void setRenderRate(int fps);  // 0 = sin límite
+
+    // Graba input + hash por tick de la escena activa (se reinicia en cada cambio de escena; se guarda al salir de ella)
+    void startRecording(const std::string& path);
+
+    // Construye la escena en un worker mientras la actual sigue corriendo; se activa sola al terminar.
+    // Grabando (modo determinista) carga síncrona, como headless
+    void preloadScene(const std::string& sceneName);
+    bool isLoading() const { return pending != nullptr; }
+    // Indicador de carga: se llama en render (main thread, dentro de BeginDrawing) mientras hay una precarga
+    void setLoadingIndicator(std::function<void(const std::string& scene, float progress)> indicator);
+
 private:
     int screen_width;
     int screen_height;
@@ -29,10 +49,38 @@ private:
     bool paused = false;
     bool cleaned = false;
 
+    float fixedDt = 1.0f / 60.0f;
+    int maxStepsPerFrame = 5;     // Evita la espiral de la muerte si un tick tarda más que fixedDt
+    float accumulator = 0.0f;
+
     std::unique_ptr<Scene> currentScene;  // Nuevo: Current scene
     std::string currentSceneName;  // Para switching
 
-    void switchScene(const std::string& sceneName);  // Nuevo
+    void switchScene(const std::string& sceneName);  // Nuevo: Síncrono (escena inicial / grabación)
+
+    // Precarga en curso: load() en loader; el RNG del worker viaja a la escena al activarla
+    struct PendingScene {
+        std::unique_ptr<Scene> scene;
+        std::string name;
+        LoadProgress progress;
+        std::atomic<bool> done{false};
+        RandomState rng{};
+        std::thread loader;
+    };
+    std::unique_ptr<PendingScene> pending;
+    std::function<void(const std::string&, float)> loadingIndicator;
+    void pollPreload();  // Main thread: activa la escena precargada si el worker terminó
+    void activateScene(std::unique_ptr<Scene> next, const std::string& sceneName);
+
+    std::string recordPath;
+    Replay recording;
+    uint64_t recordHash = 0;
+    int recordSegment = 0;  // Un replay por escena activada: el primero en recordPath, los demás con sufijo
+    void beginRecording();
+    void finishRecording();
+
+    IntGridOverlay intGridOverlay;  // Debug IntGrid (toggle en el Editor)
+    RenderQueue renderQueue;  // Comandos del frame: las escenas los generan, render() los reproduce
 
     Editor editor;  // Modificado: Pasará currentScene->getECS()
 };
\ No newline at end of file
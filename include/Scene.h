@@ -1,18 +1,48 @@
 // include/Scene.h
 #pragma once
 #include "ecs.h"
+#include "renderqueue.h"
 #include <raylib.h>
+#include <memory>
+#include <string>
+#include <atomic>
+
+// Progreso de load() en [0, 1]: lo escribe el thread que carga, lo lee Game para el indicador
+struct LoadProgress {
+    std::atomic<float> fraction{0.0f};
+    void set(float value) { fraction.store(value, std::memory_order_relaxed); }
+    float get() const { return fraction.load(std::memory_order_relaxed); }
+};
 
 class Scene {
 public:
     virtual ~Scene() = default;
-    virtual void setup() = 0;
+
+    // Carga en 3 fases (Game::preloadScene): beginLoad y activate en el main thread, load en un worker
+    // mientras la escena anterior sigue corriendo. load solo toca this->ecs y miembros propios (nada de
+    // AssetManager/GL ni estado global). setup() = las tres seguidas (headless, replays, escena inicial)
+    virtual void beginLoad() {}  // Main thread: pedir assets (decode async) y copiar lo que load necesite
+    virtual void load(LoadProgress& progress) = 0;
+    virtual void activate() {}   // Main thread, justo antes del primer update
+    void setup() {
+        LoadProgress progress;
+        beginLoad();
+        load(progress);
+        activate();
+    }
+
     virtual void update(float dt) = 0;
-    virtual void render() = 0;
+    virtual void render(RenderQueue& queue) = 0;  // Solo submit de comandos: Game hace el flush
     virtual void clean() = 0;
 
     ECS& getECS() { return ecs; }  // Acceso para editor/manager
 
+    // Fracción del tick actual ya acumulada (la setea Game antes de render)
+    float renderAlpha = 1.0f;
+
 protected:
     ECS ecs;
-};
\ No newline at end of file
+};
+
+// Factory por nombre ("Menu", "Breakout", "BreakoutStress", "Adventure", "Stress"); nullptr si no existe. Usado por Game y headless
+std::unique_ptr<Scene> createScene(const std::string& name, int width, int height);
@@ -0,0 +1,58 @@
+// include/aibatch.h
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "ecs.h"
+#include "components.h"
+
+class FlowField;
+
+// systemAI batched: las entities con MovementPattern quedan particionadas por MovementType en arrays densos
+// (con los punteros a Position/Velocity/Animation ya resueltos), y cada tipo corre su kernel sin branches por
+// entity: gather a SoA -> math SSE2 de a 4 (sincos para Circular, normalize/lerp para Tracking, distancia al
+// waypoint para Patrol) -> scatter. Las particiones se rearman solo con altas/bajas (EntityIndex::version),
+// como SpriteCuller. Resultado bit a bit igual a updateMovementPattern (ver simdmath.h)
+class AIBatch {
+public:
+    void invalidate() { dirty = true; }
+    void update(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap);
+
+    int getCount(MovementType type) const { return type == MovementType::None ? 0 : (int)lanes[(int)type - 1].size(); }
+    int getRebuilds() const { return rebuilds; }
+
+private:
+    struct Entry {
+        Entity entity;
+        MovementPattern* pattern;
+        Position* pos;
+        Velocity* vel;
+        Animation* anim;       // Opcional
+        Size* size;            // Opcional: centro para samplear el flow field
+        Entity target = -1;    // Target resuelto (se re-resuelve si pattern->target cambia)
+        Position* targetPos = nullptr;
+        PatrolRoute* route = nullptr;  // Patrol: solo se lee al llegar a un waypoint
+    };
+
+    // Columnas SoA del frame (solo las entries activas); cada kernel documenta qué guarda en cada una
+    struct Columns {
+        std::vector<float> px, py, vx, vy, tx, ty, speed, a, b;
+        std::vector<uint32_t> mask;
+        std::vector<uint32_t> entry;  // Índice en la lane
+        void resize(size_t n);
+    };
+
+    std::vector<Entry> lanes[3];  // Tracking, Circular, Patrol
+    Columns cols;
+    bool dirty = true;
+    uint64_t indexVersion = UINT64_MAX;
+    const EntityIndex* indexOwner = nullptr;
+    int rebuilds = 0;
+
+    void rebuild(ECS& ecs);
+    Position* resolveTarget(ECS& ecs, Entry& entry);
+    void runTracking(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap);
+    void runCircular(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap);
+    void runPatrol(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap);
+    // El type cambió sin alta/baja (editor): camino escalar este frame, rearmado el siguiente
+    bool typeChanged(ECS& ecs, Entry& entry, MovementType expected, float dt, const FlowField* flow, const TileMap* tilemap);
+};
@@ -0,0 +1,53 @@
+// include/ailod.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "ecs.h"
+#include "components.h"
+
+class FlowField;
+
+// AI level-of-detail: buckets por distancia a la cámara activa.
+// Near corre cada frame; Mid/Far cada N frames (sharded round-robin por entity) con el dt acumulado;
+// Dormant no corre (y se frena).
+enum class AILodBucket { Near = 0, Mid = 1, Far = 2, Dormant = 3 };
+
+struct AILodConfig {
+    float nearDistance = 900.0f;      // World units desde cam.target
+    float midDistance = 1800.0f;
+    float dormantDistance = 4000.0f;
+    int midInterval = 2;              // Frames entre ticks
+    int farInterval = 6;
+    int maxDeferredUpdates = 0;       // Budget de ticks Mid+Far por frame (0=sin límite); los que más esperan primero
+    float maxTickDt = 0.25f;          // Tope del dt acumulado por tick (un tick tardío no salta ni sobre-interpola)
+};
+
+struct AILodStats {
+    int counts[4] = {0, 0, 0, 0};     // Entidades por bucket
+    int updated[4] = {0, 0, 0, 0};    // Ticks ejecutados este frame
+    double costMs[4] = {0, 0, 0, 0};  // Tiempo de AI por bucket este frame
+    int deferred = 0;                 // Ticks Mid/Far pospuestos por el budget
+};
+
+class AILodScheduler {
+public:
+    AILodConfig config;
+
+    // Reemplaza a systemAI: mismo updateMovementPattern, pero time-sliced
+    void update(ECS& ecs, float dt, const FlowField* flow = nullptr);
+
+    const AILodStats& getStats() const { return stats; }
+
+private:
+    uint64_t frame = 0;
+    AILodStats stats;
+    struct Due {
+        Entity entity;
+        MovementPattern* pattern;
+        int bucket;
+    };
+    std::vector<std::pair<Entity, MovementPattern*>> buckets[4];  // Reusados entre frames
+    std::vector<Due> due;  // Ticks Mid/Far que compiten por el budget
+};
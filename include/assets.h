@@ -0,0 +1,105 @@
+// include/assets.h
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Texturas compartidas por path con ref-count. acquire() devuelve al instante un placeholder con las
+// dimensiones reales (leídas del header PNG) y el id GPU definitivo: el decode (LoadImage) corre en
+// workers y pumpUploads() sube los pixels en batch desde el main thread con UpdateTexture, así las copias
+// del Texture2D que ya viven en components/prefabs muestran la imagen sin tener que parchearlas.
+// Atlas: varias imágenes empaquetadas (atlas.h) en una sola página con el mismo mecanismo; el decode y el
+// armado de la página corren en un worker. Headless: solo metadata, sin decode.
+
+struct TextureHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+class AssetManager {
+public:
+    static AssetManager& instance();
+    ~AssetManager();
+
+    // Misma ruta -> mismo slot (refs++). Archivo inexistente: handle válido con textura width=0
+    TextureHandle acquire(const std::string& path);
+    Texture2D get(TextureHandle handle) const;
+
+    // Página única con todas las imágenes de `paths` (name = key de dedup). Sprites/tiles la referencian
+    // con sub-rects: region() da el rect de cada path (width 0 si no existía o no entró)
+    TextureHandle acquireAtlas(const std::string& name, const std::vector<std::string>& paths, int maxSize = 2048);
+    Rectangle region(TextureHandle atlas, const std::string& path) const;
+    // Copia de todas las regiones (path -> rect): para usarlas fuera del main thread (carga de escenas)
+    std::unordered_map<std::string, Rectangle> regions(TextureHandle atlas) const;
+
+    bool ready(TextureHandle handle) const;  // Pixels reales ya en GPU (o headless)
+
+    // refs--; con 0 refs se descarga. Deja el handle inválido: soltarlo dos veces es un no-op
+    void release(TextureHandle& handle);
+
+    // Main thread, 1 vez por frame: sube hasta maxUploads imágenes decodificadas
+    void pumpUploads(int maxUploads = 16);
+    void waitAll();  // Bloquea hasta subir todo lo pendiente (e.g. antes de capturar un frame)
+
+    size_t getPending() const { return pendingDecodes; }
+    size_t getLiveTextures() const { return byPath.size(); }
+
+private:
+    AssetManager() = default;
+
+    struct Slot {
+        std::string path;
+        Texture2D texture = {};
+        int refs = 0;
+        uint32_t generation = 0;
+        bool uploaded = false;
+        std::unordered_map<std::string, Rectangle> regions;  // Solo atlas
+    };
+    struct AtlasPart {
+        std::string path;
+        Rectangle rect;
+    };
+    struct DecodeJob {
+        uint32_t slot;
+        uint32_t generation;
+        std::string path;
+        std::vector<AtlasPart> parts;  // No vacío: armar página de width x height con estas imágenes
+        int width = 0, height = 0;
+    };
+    struct Decoded {
+        uint32_t slot;
+        uint32_t generation;
+        Image image;
+    };
+
+    // Main thread
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<std::string, uint32_t> byPath;
+    std::vector<Decoded> toUpload;  // Decodificadas que no entraron en el batch del frame
+    size_t pendingDecodes = 0;
+
+    // Compartido con workers
+    std::deque<DecodeJob> jobs;
+    std::vector<Decoded> decoded;
+    std::mutex mutex;
+    std::condition_variable jobCv;   // Hay trabajo / quit
+    std::condition_variable doneCv;  // Un decode terminó (waitAll)
+    std::vector<std::thread> workers;
+    bool quit = false;
+
+    uint32_t allocSlot(const std::string& key);
+    void enqueue(DecodeJob&& job);
+    bool validHandle(TextureHandle handle) const;
+    static Image composeAtlas(const DecodeJob& job);
+    void startWorkers();
+    void workerLoop();
+    void upload(Decoded& item);
+};
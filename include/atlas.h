@@ -0,0 +1,33 @@
+// include/atlas.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <cstddef>
+
+// Packer skyline (bottom-left) para armar una página de atlas con varias imágenes.
+// Cada rect se separa con `padding` px (se rellenan extruyendo el borde: sin bleeding al escalar).
+
+struct AtlasInput {
+    int width = 0, height = 0;
+};
+
+struct AtlasLayout {
+    int width = 0, height = 0;       // Página (potencias de 2)
+    std::vector<Rectangle> rects;    // Mismo orden que los inputs (sin padding)
+};
+
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+    bool insert(int w, int h, int& outX, int& outY);  // false si no entra
+
+private:
+    struct Segment { int x, y, w; };
+    int width, height;
+    std::vector<Segment> skyline;
+
+    bool fits(size_t index, int w, int h, int& outY) const;
+};
+
+// Página más chica (empezando por el área total) donde entren todos; false si no entra en maxSize
+bool packAtlas(const std::vector<AtlasInput>& inputs, int padding, int maxSize, AtlasLayout& out);
@@ -0,0 +1,63 @@
+// include/breakout.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "ecs.h"
+#include "renderqueue.h"
+
+// Breakout a escala (100x100 bloques, ~1000 balls): los bloques no son entities sino un grid regular con
+// bitset de vivos + hit points por celda, y las balls van en SoA. Ball-bloque = lookup O(1) por celda a lo
+// largo del barrido; integración/paredes/paddle = kernel vectorizado (SSE2, fallback escalar).
+// Ambos viven como component singleton de una entity de la escena (como TileMap), así entran en el hash de replay.
+
+struct BlockGrid {
+    int cols = 0, rows = 0;
+    int wordsPerRow = 0;               // Cada fila arranca en un word: scans por fila sin shifts
+    Vector2 origin = {0, 0};           // Esquina superior izquierda en pantalla
+    float cellW = 0, cellH = 0;        // Colisión contra la celda completa
+    float gap = 0;                     // Solo visual: margen entre bloques al dibujar
+    std::vector<uint64_t> alive;       // rows * wordsPerRow
+    std::vector<uint8_t> hp;           // cols * rows, 0 = vacía
+    int aliveCount = 0;
+
+    void resize(int c, int r);
+    bool isAlive(int cx, int cy) const { return (alive[cy * wordsPerRow + (cx >> 6)] >> (cx & 63)) & 1u; }
+    void set(int cx, int cy, uint8_t hitPoints);
+    bool damage(int cx, int cy);  // Resta 1 hp; true si el bloque se rompió
+    Rectangle bounds() const { return {origin.x, origin.y, cols * cellW, rows * cellH}; }
+    Rectangle cellRect(int cx, int cy) const { return {origin.x + cx * cellW, origin.y + cy * cellH, cellW, cellH}; }
+};
+
+// Balls en SoA (mismo tamaño para todas): el kernel procesa 4 por iteración
+struct BallSet {
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> prevX, prevY;  // Posición al inicio del tick (render interpolado)
+    std::vector<uint32_t> swept;      // Scratch del kernel: ~0u si ya la movió el sweep contra el grid
+    float size = 15.0f;
+
+    size_t count() const { return x.size(); }
+    void add(float px, float py, float pvx, float pvy);
+    void removeAt(size_t i);  // Swap con la última
+};
+
+struct BreakoutStepStats {
+    int candidates = 0;  // Balls cuyo barrido tocó los bounds del grid (sweep escalar)
+    int hits = 0;        // Golpes a bloques
+    int broken = 0;      // Bloques rotos
+    int lost = 0;        // Balls que salieron por abajo (removidas)
+};
+
+// Nivel: texto con "size cols rows", "cell w h", "origin x y", "gap g", "balls n size speed y" y luego
+// `rows` filas de `cols` chars ('.' = vacío, '1'..'9' = hp). '#' comenta (ver assets/levels/breakout.txt)
+bool loadBreakoutLevel(const std::string& path, BlockGrid& grid, BallSet& balls, int screenWidth);
+// Abanico de `count` balls a la altura y (count = 1: una sola al centro, subiendo recto)
+void spawnBalls(BallSet& balls, int count, float size, float speed, float y, int screenWidth);
+
+// Un tick: copia prev, sweep escalar contra el grid para las balls que lo tocan, kernel SIMD para el resto
+// (integra) + paredes + paddle, y remueve las que cayeron. Sin ECS: lo usa el bench directo
+BreakoutStepStats stepBalls(BallSet& balls, BlockGrid& grid, Rectangle paddle, float dt, float screenWidth, float screenHeight);
+
+void systemBreakoutBalls(ECS& ecs, float dt, int screenWidth, int screenHeight, BreakoutStepStats& stats);
+void systemRenderBreakout(ECS& ecs, RenderQueue& queue, float alpha);
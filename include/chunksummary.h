@@ -0,0 +1,67 @@
+// include/chunksummary.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "ecs.h"
+#include "components.h"
+#include "renderqueue.h"
+
+// Resúmenes multi-resolución del tilemap para vistas alejadas y el minimapa. Por chunk, el render de sus tiles
+// reducido a 1/4, 1/16 y 1/64 de lado (con tiles de 16: 4, 1 y 1/4 texels por tile). Niveles 1 y 2: una textura
+// por chunk; nivel 3: una página única de todo el mapa (es el minimapa, y el nivel 3 del mundo dibuja de ahí).
+// Como IntGridOverlay: si cambió la revision del TileMap, firma por chunk y solo se rearman los distintos.
+// Los texels salen de un sample reducido por tile de origen (textura + sub-rect) leído una vez de GPU; sin
+// pixels (headless o atlas sin subir) cada tile es un color plano por IntGridValue
+class ChunkSummaries {
+public:
+    static constexpr int kLevels = 3;  // Sin contar el 0 (tiles)
+
+    ~ChunkSummaries();
+    // Main thread (GL). texturesReady: el atlas ya tiene sus pixels (AssetManager::ready); al cambiar se rearma todo
+    void sync(const TileMap& tilemap, bool texturesReady);
+    void clear();  // Cambio de escena: suelta texturas y samples
+
+    // 0 = tiles; 1..3 = el resumen con ~1 texel por pixel de pantalla (lodBias > 0 pasa antes a los gruesos)
+    int levelForZoom(const TileMap& tilemap, float zoom) const;
+    // Un quad por chunk visible del nivel (1..3), layer Tiles
+    void submit(const TileMap& tilemap, CommandBuffer& out, Rectangle view, int level);
+    // Minimapa (Hud) ajustado a screenRect: la página entera + rect de la vista y el player
+    void submitMinimap(const TileMap& tilemap, CommandBuffer& out, Rectangle screenRect, Rectangle view, Vector2 player);
+
+    float lodBias = 0.0f;  // En niveles
+
+    int getChunkCount() const { return (int)chunks.size(); }
+    int getLastRebuilds() const { return lastRebuilds; }
+    int getLastDrawn() const { return lastDrawn; }
+    int getSampleCount() const { return (int)sampleIndex.size(); }
+
+private:
+    struct Chunk {
+        Texture2D levels[kLevels - 1] = {};  // 1 y 2 (el 3 vive en page)
+        uint64_t signature = 0;
+    };
+    std::vector<Chunk> chunks;
+    Texture2D page = {};     // Nivel 3 de todos los chunks: chunksX*side[2] x chunksY*side[2]
+    int side[kLevels] = {};  // Lado en texels de un chunk por nivel
+    int sampleSize = 0;      // Lado del sample de un tile (nivel 1)
+    int width = 0, height = 0, chunkSize = 0, tileSize = 0, chunksX = 0, chunksY = 0;
+    unsigned int revision = 0;
+    bool built = false;
+    bool sourcesReady = false;
+    int lastRebuilds = 0, lastDrawn = 0;
+
+    // Samples por tile de origen: key (textura, sub-rect) -> offset en samples (kNoSample: sin pixels)
+    static constexpr uint32_t kNoSample = 0xFFFFFFFFu;
+    std::unordered_map<uint64_t, uint32_t> sampleIndex;
+    std::vector<Color> samples;
+    std::unordered_map<unsigned int, Image> sources;  // Readback por id de textura
+    std::vector<Color> scratch[kLevels];              // Un chunk por nivel
+    Vector2 minimapLines[8] = {};                     // Del frame: el comando apunta acá hasta el flush
+
+    uint64_t computeSignature(const TileMap& tilemap, int cx, int cy) const;
+    void rebuild(const TileMap& tilemap, int cx, int cy, Chunk& chunk);
+    const Color* tileSample(const TileMap& tilemap, const Tile& tile);
+    void releaseSources();
+};
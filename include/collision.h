@@ -0,0 +1,37 @@
+// include/collision.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include "ecs.h"
+#include "components.h"
+
+// Colisión continua: swept AABB vs AABB y sweep por ejes contra tiles sólidos.
+// Evita tunneling de entidades rápidas y permite deslizar a lo largo de muros.
+
+struct SweepHit {
+    bool hit = false;
+    float t = 1.0f;              // Fracción de delta recorrida antes del contacto [0,1]
+    Vector2 normal = {0, 0};     // Normal de la cara golpeada (eje dominante)
+};
+
+// Caja moviéndose delta contra target estático. Si ya se solapan: t=0 y normal por menor penetración
+SweepHit sweepAABB(Rectangle moving, Vector2 delta, Rectangle target);
+
+struct SweepBody {
+    Rectangle box;   // Collider en world space (w/h pueden ser 0 = punto)
+    Vector2 delta;   // Desplazamiento deseado este frame
+};
+
+struct TileSweep {
+    Vector2 pos = {0, 0};  // Origen (x,y) resuelto del box
+    bool hitX = false;     // Bloqueado en X -> anular vel.x (desliza en Y)
+    bool hitY = false;
+};
+
+// Traversal de la grid por ejes (X luego Y), recorriendo cada columna/fila cruzada.
+// Fuera del mapa cuenta como sólido (igual que systemMovement original)
+bool isSolidTile(const TileMap& tilemap, int tx, int ty);
+TileSweep sweepTiles(const TileMap& tilemap, Rectangle box, Vector2 delta);
+
+// Batch: resuelve todos los bodies en un solo pase lineal (out se redimensiona a bodies.size())
+void sweepMany(const TileMap& tilemap, const std::vector<SweepBody>& bodies, std::vector<TileSweep>& out);
@@ -2,22 +2,26 @@
 
 #pragma once
 #include <raylib.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include "ecs.h"
+#include "waypoints.h"
 
 
 using Entity = size_t;  // Forward alias—igual que en ecs.h, evita dependencia circular
 
 enum class AnimationMode { Sheet, Separate };
 
-struct Position { Vector2 pos; };  // Cambiado a Vector2
+struct Position {  // Cambiado a Vector2
+    Vector2 pos;
+    Vector2 prev = {0, 0};  // pos al inicio del tick (render interpolado)
+    bool hasPrev = false;   // false = recién creada/teletransportada, dibujar en pos
+};
 struct Velocity { Vector2 vel; };  // Cambiado a Vector2
 struct Size { float w, h; };  // Mantiene, pero podría ser Vector2
 struct PaddleControlled {};  // Viejo, mantiene
-struct Ball {};
-struct Block {};
 
 // Modificado para híbrido
 struct Sprite {
@@ -29,15 +33,39 @@ struct Sprite {
     Vector2 scale = {1.0f, 1.0f};  // Nuevo: Escala por sprite (default 1x)
 };
 
-// Modificado para híbrido: Un mapa por tipo de frame
+// Región que se dibuja: frameRec en sheets (la textura es la página del atlas), la textura entera si no
+inline Rectangle spriteSourceRect(const Sprite& sprite) {
+    return sprite.isSheet ? sprite.frameRec : Rectangle{0, 0, (float)sprite.texture.width, (float)sprite.texture.height};
+}
+// Tamaño en mundo (source rect escalado): hitbox de enemies y player
+inline Size spriteSize(const Sprite& sprite) {
+    const Rectangle src = spriteSourceRect(sprite);
+    return {src.width * sprite.scale.x, src.height * sprite.scale.y};
+}
+
+// Estados de animación: la AI escribe uno por entity por tick (1 byte, antes un std::string)
+enum class AnimState : uint8_t { Idle, WalkLeft, WalkRight, Count };
+constexpr int kAnimStateCount = (int)AnimState::Count;
+inline const char* animStateName(AnimState state) {
+    static const char* names[kAnimStateCount] = {"idle", "walk_left", "walk_right"};
+    return (int)state < kAnimStateCount ? names[(int)state] : "?";
+}
+inline bool parseAnimState(const std::string& name, AnimState& out) {  // Inverso (prefabs)
+    for (int i = 0; i < kAnimStateCount; ++i) {
+        if (name == animStateName((AnimState)i)) { out = (AnimState)i; return true; }
+    }
+    return false;
+}
+
+// Modificado para híbrido: frames por estado, indexados por AnimState
 struct Animation {
-    std::string currentState = "idle";
+    AnimState currentState = AnimState::Idle;
     AnimationMode mode = AnimationMode::Sheet;  // Default sheet
-    std::unordered_map<std::string, std::vector<Rectangle>> rectStates;  // Para sheet
-    std::unordered_map<std::string, std::vector<Texture2D>> texStates;   // Para separate
     int currentFrame = 0;
     float frameTime = 0.1f;
     float timer = 0.0f;
+    std::vector<Rectangle> rectStates[kAnimStateCount];  // Para sheet
+    std::vector<Texture2D> texStates[kAnimStateCount];   // Para separate
 };
 
 // Nuevo: Para control por input
@@ -79,10 +107,17 @@ struct TileMap {
     int maxWidth = 50;       // Límite
     int maxHeight = 50;
     unsigned int seed = 12345;  // Para Perlin consistente
+    unsigned int revision = 0;  // Incrementar al cambiar tiles (invalida caches: flow field, etc.)
 
     Texture2D wallTex = {0};
     Texture2D hazardTex = {0};
     Texture2D pickupTex = {0};
+
+    // Atlas: origen del tileset dentro de su textura y sub-rects de los specials (width 0 = textura completa)
+    Vector2 tilesetOrigin = {0, 0};
+    Rectangle wallSrc = {0, 0, 0, 0};
+    Rectangle hazardSrc = {0, 0, 0, 0};
+    Rectangle pickupSrc = {0, 0, 0, 0};
 };
 
 // Nuevo: Para interacciones (añade a player si hazard/pickup)
@@ -94,31 +129,54 @@ struct CameraComp {  // Renombrado para evitar conflicto con Raylib's Camera2D
     Camera2D cam = {0};  // Raylib struct: offset, target, rotation, zoom
     Entity target = -1;   // Entity a seguir (e.g., player)
     float smoothSpeed = 0.1f;  // Para lerp follow (opcional, 0=instant)
+    Vector2 prevTarget = {0, 0};  // cam.target del tick anterior (render interpolado)
 };
 
-enum class MovementType { None, Tracking, Circular, Patrol };
+enum class MovementType : uint8_t { None, Tracking, Circular, Patrol };
 
-struct MovementPattern {
-    MovementType type = MovementType::None;
-    float speed = 100.0f;  // Compartido: Velocidad base
-
-    // Para Tracking
-    Entity target = -1;    // e.g., player
+// Nuevo: MovementPattern es el registro hot (lo que el kernel de cada tipo lee/escribe por frame): campos
+// comunes + los params del tipo activo en un union. La config fría de Patrol (la ruta) va en PatrolRoute
+struct TrackingParams {
     float pursuitDistance = 500.0f;  // Max dist para perseguir (0=siempre)
     float lerpFactor = 0.1f;  // Suavizado (0=instant, 1=ninguno)
-
-    // Para Circular
+};
+struct CircularParams {
     Vector2 center = {0.0f, 0.0f};  // Punto fijo
     float radius = 100.0f;
     float angularSpeed = 2.0f;  // rad/s (positivo=anti-clockwise)
     float currentAngle = 0.0f;  // Estado interno
-    bool aroundTarget = false;  // Si true, center = target pos dinámica
+};
+struct PatrolParams {
+    Vector2 waypoint = {0.0f, 0.0f};  // Cache de route.points[current]: el kernel no toca la ruta salvo al llegar
+    float arrivalThreshold = 5.0f;  // Dist para cambiar waypoint
+    uint16_t current = 0;  // Estado interno
+    uint16_t count = 0;    // Puntos de la ruta (0 = sin ruta, quieto)
+};
 
-    // Para Patrol
-    std::vector<Vector2> waypoints;  // Puntos a patrullar
-    size_t currentWaypoint = 0;  // Estado interno
+struct MovementPattern {
+    Entity target = -1;    // Tracking / Circular con aroundTarget (e.g., player)
+    float speed = 100.0f;  // Compartido: Velocidad base
+    float lodTimer = 0.0f;  // Estado interno: dt acumulado desde el último tick (AI LOD)
+    MovementType type = MovementType::None;
+    bool aroundTarget = false;  // Circular: si true, center = target pos dinámica
+    union {  // Solo el del type activo es válido
+        TrackingParams tracking;
+        CircularParams circular;
+        PatrolParams patrol;
+    };
+
+    MovementPattern() : tracking{} {}
+    // Cambian el type y resetean los params a los defaults del tipo
+    void setTracking(const TrackingParams& p = {}) { type = MovementType::Tracking; tracking = p; }
+    void setCircular(const CircularParams& p = {}) { type = MovementType::Circular; circular = p; }
+    void setPatrol(const PatrolParams& p = {}) { type = MovementType::Patrol; patrol = p; }
+    void setNone() { type = MovementType::None; tracking = {}; }
+};
+
+// Cold: ruta de Patrol (solo se lee al llegar a un waypoint). Ver syncPatrolRoute en systems.h
+struct PatrolRoute {
+    WaypointList points;  // Inline hasta 8 puntos; más, en el arena compartido (waypoints.h)
     bool loop = true;  // Repetir ciclo
-    float arrivalThreshold = 5.0f;  // Dist para cambiar waypoint
 };
 
 
@@ -134,5 +192,11 @@ struct EnemySpawner {
     float radius = 100.0f;    // Para Circular
     Vector2 areaSize = {200.0f, 200.0f};  // Para Random: ancho/alto del rect
     float activeDistance = 300.0f;  // Spawn solo si player < esta dist (0=siempre)
+    int maxAlive = 12;        // Cap de enemies vivos de este spawner
+    float despawnDistance = 1500.0f;  // Despawn si el enemy se aleja más que esto del player (0=nunca)
     float timer = 0.0f;       // Estado interno
+    int alive = 0;            // Estado interno: enemies vivos de este spawner
 };
+
+// Nuevo: Enemy creado por un spawner (para caps y despawn)
+struct SpawnedBy { Entity spawner = -1; };
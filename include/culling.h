@@ -0,0 +1,73 @@
+// include/culling.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "ecs.h"
+#include "components.h"
+
+// View culling de sprites: grid de celdas (bucket por celda) con los bounds escalados (Position + Sprite) y
+// query por el rect de la cámara. Rebuild completo solo con altas/bajas de components (version del índice) o
+// invalidate (shift de todo el mundo). Tras un tick solo se re-ubican los sprites con Velocity, y solo tocan
+// buckets los que cambiaron de celda. El set visible se cachea mientras la cámara no cruce una celda y ningún
+// sprite cambie de celda (query = vista + margen, redondeada a celdas).
+
+struct CullStats {
+    int total = 0;       // Sprites en el mundo
+    int candidates = 0;  // Devueltos por el grid (vista + margen)
+    int drawn = 0;       // Pasaron el test exacto contra la vista
+    int culled = 0;      // total - drawn
+    bool cached = false; // Se reusó el set visible del frame anterior
+    int rebuilds = 0;    // Reconstrucciones del grid (acumulado)
+    int movers = 0;      // Sprites con Velocity revisados por tick
+    int relocated = 0;   // De esos, los que cambiaron de celda en el último update
+};
+
+// Rect de Sprite en world space (origin y scale aplicados)
+Rectangle spriteBounds(const Sprite& sprite, Vector2 pos);
+// Rect visible de una cámara 2D sin rotación
+Rectangle cameraViewRect(const Camera2D& cam);
+
+class SpriteCuller {
+public:
+    explicit SpriteCuller(float cellSize = 256.0f, float margin = 128.0f);
+
+    void markMoved() { moved = true; }   // Llamar en cada tick: re-ubica los sprites con Velocity
+    void invalidate() { dirty = true; }  // Cambio de posiciones fuera de Velocity (shift por expansión): rebuild
+
+    // Candidatos para la vista, ordenados por entity (orden de dibujo estable)
+    const std::vector<Entity>& query(ECS& ecs, Rectangle view);
+
+    CullStats stats;
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+        bool operator==(const CellRange& o) const { return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1; }
+    };
+    // Punteros a los components: estables mientras no haya bajas (que cambian la version y fuerzan rebuild)
+    struct Mover {
+        Entity entity;
+        const Position* pos;
+        const Sprite* sprite;
+        CellRange cells;
+    };
+
+    float cellSize;
+    float margin;  // Sprites grandes/rápidos: se buscan un poco fuera de la vista
+    bool dirty = true;
+    bool moved = false;
+    uint64_t indexVersion = UINT64_MAX;
+    const EntityIndex* indexOwner = nullptr;
+    int cachedCells[4] = {0, 0, -1, -1};  // x0, y0, x1, y1 del último query
+    std::unordered_map<uint64_t, std::vector<Entity>> buckets;  // Celda -> sprites (vacíos se conservan: sin allocs)
+    std::vector<Mover> movers;
+    std::vector<Entity> visible;
+
+    CellRange cellsOf(const Sprite& sprite, const Position& pos) const;
+    void place(Entity entity, const CellRange& cells);
+    void unplace(Entity entity, const CellRange& cells);
+    void rebuild(ECS& ecs);
+    bool updateMovers();  // true si algún sprite cambió de celda
+};
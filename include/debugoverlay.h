@@ -0,0 +1,64 @@
+// include/debugoverlay.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <cstdint>
+#include "ecs.h"
+#include "components.h"
+#include "renderqueue.h"
+
+// Overlays de debug con costo ~0 en steady state: se regeneran solo cuando cambia lo que muestran.
+
+// IntGrid: una textura chica por chunk (1 pixel = 1 tile, filtro point) dibujada escalada al tamaño del chunk.
+// Como ChunkPathfinder::sync: si la revision del TileMap cambió, firma por chunk y solo se re-suben los
+// chunks distintos. Submit = un quad por chunk visible (y no vacío)
+class IntGridOverlay {
+public:
+    ~IntGridOverlay();
+    void submit(const TileMap& tilemap, CommandBuffer& out, Rectangle view);
+    void clear();  // Cambio de escena: suelta las texturas
+
+    int getChunkCount() const { return (int)chunks.size(); }
+    int getLastUploads() const { return lastUploads; }
+    int getLastDrawn() const { return lastDrawn; }
+
+private:
+    struct Chunk {
+        Texture2D texture = {};
+        uint64_t signature = 0;
+        bool empty = true;  // Todo WALKABLE: no se dibuja
+    };
+    std::vector<Chunk> chunks;
+    std::vector<Color> pixels;  // Scratch de un chunk
+    int width = 0, height = 0, chunkSize = 0, chunksX = 0, chunksY = 0;
+    unsigned int revision = 0;
+    bool built = false;
+    int lastUploads = 0, lastDrawn = 0;
+
+    void sync(const TileMap& tilemap);
+    uint64_t computeSignature(const TileMap& tilemap, int cx, int cy) const;
+    void upload(const TileMap& tilemap, int cx, int cy, Chunk& chunk);
+};
+
+// Spawners: líneas/círculos/rects teselados una vez en un draw list (vértices en world space). Se rearma
+// solo si cambia la firma de los spawners (e.g. shift por expansión); submit = un comando de líneas + uno de
+// triángulos (centros) con los vértices de los spawners dentro de la vista
+class SpawnerOverlay {
+public:
+    void submit(ECS& ecs, CommandBuffer& out, Rectangle view);
+
+private:
+    struct Range {
+        Rectangle bounds;
+        uint32_t lineStart, lineCount;  // En lines (pares de vértices)
+        uint32_t triStart, triCount;    // En tris (ternas)
+    };
+    std::vector<Vector2> lines;
+    std::vector<Vector2> tris;
+    std::vector<Range> ranges;
+    std::vector<Vector2> visibleLines;  // Del frame: los comandos apuntan acá hasta el flush
+    std::vector<Vector2> visibleTris;
+    uint64_t signature = 0;
+
+    void rebuild(ECS& ecs);
+};
@@ -6,20 +6,128 @@
 #include <type_traits>
 #include <vector>      
 #include <unordered_set> 
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <algorithm>
 #include "components.h"     
 
 using Entity = size_t;
 
+class Prefab;  // include/prefab.h
+
+// Nuevo: Bit por tipo de component (filtros del editor). Tipos sin bit cuentan igual para "entity viva"
+template<typename T> inline constexpr uint32_t componentBit = 0;
+template<> inline constexpr uint32_t componentBit<Position> = 1u << 0;
+template<> inline constexpr uint32_t componentBit<Velocity> = 1u << 1;
+template<> inline constexpr uint32_t componentBit<Size> = 1u << 2;
+template<> inline constexpr uint32_t componentBit<Sprite> = 1u << 3;
+template<> inline constexpr uint32_t componentBit<Animation> = 1u << 4;
+template<> inline constexpr uint32_t componentBit<InputControlled> = 1u << 5;
+template<> inline constexpr uint32_t componentBit<AIPatrol> = 1u << 6;
+template<> inline constexpr uint32_t componentBit<MovementPattern> = 1u << 7;
+template<> inline constexpr uint32_t componentBit<EnemySpawner> = 1u << 8;
+template<> inline constexpr uint32_t componentBit<SpawnedBy> = 1u << 9;
+template<> inline constexpr uint32_t componentBit<TileMap> = 1u << 10;
+template<> inline constexpr uint32_t componentBit<CameraComp> = 1u << 11;
+template<> inline constexpr uint32_t componentBit<Health> = 1u << 12;
+template<> inline constexpr uint32_t componentBit<Score> = 1u << 13;
+template<> inline constexpr uint32_t componentBit<PaddleControlled> = 1u << 14;
+template<> inline constexpr uint32_t componentBit<Tile> = 1u << 15;
+template<> inline constexpr uint32_t componentBit<PatrolRoute> = 1u << 16;
+inline constexpr const char* kComponentNames[] = {
+    "Position", "Velocity", "Size", "Sprite", "Animation", "InputControlled", "AIPatrol", "MovementPattern", "EnemySpawner",
+    "SpawnedBy", "TileMap", "CameraComp", "Health", "Score", "PaddleControlled", "Tile", "PatrolRoute"};
+inline constexpr int kComponentBitCount = sizeof(kComponentNames) / sizeof(kComponentNames[0]);
+
+// Nuevo: Índice incremental de entities vivas (>= 1 component) con su máscara de components.
+// Lo mantienen add/remove/extract/restore (O(1) por cambio): el editor no recorre los maps cada frame
+struct EntityIndex {
+    static constexpr uint32_t kAbsent = UINT32_MAX;
+    struct Entry {
+        uint32_t slot = kAbsent;  // Posición en dense
+        uint32_t count = 0;       // Components vivos
+        uint32_t mask = 0;
+    };
+    std::vector<Entity> dense;   // Orden de alta; bajas por swap-remove
+    std::vector<Entry> sparse;   // Por id (ids secuenciales de createEntity): sin hash en add/remove
+    uint64_t version = 0;        // Cambia con cada alta/baja/cambio de máscara (caches del editor)
+
+    void add(Entity e, uint32_t bit) {
+        if (e >= sparse.size()) sparse.resize(std::max<size_t>(e + 1, sparse.size() * 2));
+        Entry& entry = sparse[e];
+        if (entry.slot == kAbsent) {
+            entry.slot = (uint32_t)dense.size();
+            dense.push_back(e);
+        }
+        entry.count++;
+        entry.mask |= bit;
+        ++version;
+    }
+
+    void remove(Entity e, uint32_t bit) {
+        if (e >= sparse.size() || sparse[e].slot == kAbsent) return;
+        Entry& entry = sparse[e];
+        entry.mask &= ~bit;
+        ++version;
+        if (--entry.count > 0) return;
+        uint32_t slot = entry.slot;
+        Entity last = dense.back();
+        dense[slot] = last;
+        dense.pop_back();
+        sparse[last].slot = slot;
+        entry = Entry{};
+    }
+
+    uint32_t mask(Entity e) const {
+        return e < sparse.size() ? sparse[e].mask : 0;
+    }
+};
+
+// Nuevo: Storage por tipo de component, uno por ECS (antes un map static compartido por todas las escenas).
+// Cada escena es su propio mundo: la siguiente se puede construir en un worker mientras la actual corre
+struct ComponentStorageBase {
+    virtual ~ComponentStorageBase() = default;
+};
+
+template<typename T>
+struct ComponentStorage : ComponentStorageBase {
+    std::unordered_map<Entity, T> map;
+};
+
+// Id denso por tipo (orden de primer uso), índice en ECS::storages
+inline size_t nextComponentTypeId() {
+    static std::atomic<size_t> next{0};
+    return next++;
+}
+template<typename T>
+size_t componentTypeId() {
+    static const size_t id = nextComponentTypeId();
+    return id;
+}
+
 class ECS {
 public:
     Entity createEntity() {
         return nextEntity++;
     }
 
+    // Nuevo: Rango contiguo [first, first+count)
+    Entity createEntities(size_t count) {
+        Entity first = nextEntity;
+        nextEntity += count;
+        return first;
+    }
+
+    // Nuevo: N entities desde un prefab (definido en prefab.h). initFn(entity, i) ajusta cada una
+    template<typename InitFn>
+    Entity instantiate(const Prefab& prefab, size_t count, InitFn&& initFn);
+    Entity instantiate(const Prefab& prefab, size_t count);
+
     template<typename T>
     void addComponent(Entity e, T comp) {
         auto& map = getComponentMap<T>();
-        map[e] = comp;
+        if (map.insert_or_assign(e, std::move(comp)).second) getEntityIndex().add(e, componentBit<T>);
     }
 
     template<typename T>
@@ -32,14 +140,35 @@ public:
 
     template<typename T>
     std::unordered_map<Entity, T>& getComponentMap() {
-        static std::unordered_map<Entity, T> map;
-        return map;
+        const size_t id = componentTypeId<T>();
+        if (id >= storages.size()) storages.resize(id + 1);
+        if (!storages[id]) storages[id] = std::make_unique<ComponentStorage<T>>();
+        return static_cast<ComponentStorage<T>*>(storages[id].get())->map;
     }
 
+    EntityIndex& getEntityIndex() { return index; }
+
     template<typename T>
     void removeComponent(Entity e) {
         auto& map = getComponentMap<T>();
-        map.erase(e);
+        if (map.erase(e)) getEntityIndex().remove(e, componentBit<T>);
+    }
+
+    // Nuevo: Saca el nodo del map sin liberarlo (para pools); restoreComponent lo reinserta sin alloc
+    template<typename T>
+    typename std::unordered_map<Entity, T>::node_type extractComponent(Entity e) {
+        auto node = getComponentMap<T>().extract(e);
+        if (!node.empty()) getEntityIndex().remove(e, componentBit<T>);
+        return node;
+    }
+
+    template<typename T>
+    T* restoreComponent(typename std::unordered_map<Entity, T>::node_type&& node) {
+        if (node.empty()) return nullptr;
+        auto result = getComponentMap<T>().insert(std::move(node));
+        if (!result.inserted) return nullptr;
+        getEntityIndex().add(result.position->first, componentBit<T>);
+        return &result.position->second;
     }
 
     template<typename T>
@@ -47,19 +176,9 @@ public:
         auto& map = getComponentMap<T>();
         return map.find(e) != map.end();
     }
-    // Nuevo: Query all entities (genérico para editor)
+    // Nuevo: Query all entities (genérico para editor); copia del índice, sin merge de maps
     std::vector<Entity> getAllEntities() {
-        std::unordered_set<Entity> uniqueEntities;
-        // Merge de todos los component maps (evita dups)
-        auto mergeMap = [&](auto& map) {
-            for (auto& [e, _] : map) uniqueEntities.insert(e);
-        };
-        mergeMap(getComponentMap<Position>());
-        mergeMap(getComponentMap<Sprite>());  // Prioriza visuals
-        mergeMap(getComponentMap<InputControlled>());
-        mergeMap(getComponentMap<AIPatrol>());
-        // Agrega más si expandes (e.g., Block, Ball)
-        return std::vector<Entity>(uniqueEntities.begin(), uniqueEntities.end());
+        return getEntityIndex().dense;
     }
 
     // Nuevo: Remove entity completely (erase from all component maps)
@@ -69,8 +188,6 @@ public:
         removeComponent<Velocity>(e);
         removeComponent<Size>(e);
         removeComponent<PaddleControlled>(e);
-        removeComponent<Ball>(e);
-        removeComponent<Block>(e);
         removeComponent<Sprite>(e);
         removeComponent<Animation>(e);
         removeComponent<InputControlled>(e);
@@ -80,14 +197,17 @@ public:
         removeComponent<Score>(e);
         removeComponent<CameraComp>(e);
         removeComponent<MovementPattern>(e);
+        removeComponent<PatrolRoute>(e);
         removeComponent<EnemySpawner>(e);
-        // Si añades más components (e.g., future Door), agrega aquí
+        removeComponent<SpawnedBy>(e);
+        removeComponent<AIPatrol>(e);
+        // Si añades más components (e.g., future Door), agrega aquí (y su componentBit)
     }
 
     
 
 private:
     Entity nextEntity = 0;
-    
-    
-};
\ No newline at end of file
+    std::vector<std::unique_ptr<ComponentStorageBase>> storages;  // Por componentTypeId (lazy)
+    EntityIndex index;
+};
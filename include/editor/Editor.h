@@ -3,20 +3,46 @@
 #include "../ecs.h"
 #include "../components.h"
 #include <imgui.h>
+#include <vector>
+#include <cstdint>
 
 class Scene;  // Forward declare
+class AILodScheduler;
+class SpriteCuller;
+class StressScene;
+class RenderQueue;
+class ChunkSummaries;
 
 class Editor {
 public:
     Editor(bool& paused_ref);  // Removido ECS ref, lo tomará de scene
-    void renderGUI(Scene* currentScene);  // Modificado: Toma scene
+    void renderGUI(Scene* currentScene, const RenderQueue* renderQueue = nullptr);  // Modificado: Toma scene
     bool debugIntGrid = false;  // Toggle para overlays
 
 private:
     bool& paused;
     Entity selectedEntity = -1;
 
+    // Entity browser: filtros (todos los components marcados) + búsqueda por id/component.
+    // La vista filtrada se cachea y solo se rehace si cambia el filtro o el índice (máx 4 veces/s)
+    uint32_t entityFilterMask = 0;
+    char entitySearch[64] = "";
+    std::vector<Entity> filteredEntities;
+    uint64_t filteredVersion = UINT64_MAX;
+    const EntityIndex* filteredIndex = nullptr;  // Cada escena tiene su índice: cambio de escena = rebuild
+    uint32_t filteredMask = 0;
+    char filteredSearch[64] = "";
+    double filteredTime = 0.0;
+    void rebuildEntityFilter(ECS& ecs);
+
     void drawEntityList(ECS& ecs);
     void drawInspector(ECS& ecs);
     void drawControls();
+    void drawAILod(AILodScheduler& lod);
+    void drawCulling(const SpriteCuller& culler);
+    void drawChunkLod(ECS& ecs, ChunkSummaries& summaries, bool* showMinimap);  // showMinimap null: sin minimapa
+    void drawRenderQueue(const RenderQueue& queue);
+    void drawProfiler();
+    void drawMemory(ECS& ecs);
+    void drawStress(StressScene& stress);
 };
\ No newline at end of file
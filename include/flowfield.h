@@ -0,0 +1,84 @@
+// include/flowfield.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "ecs.h"
+#include "components.h"
+
+// Flow field compartido: un BFS desde el goal (player) sobre tiles caminables del TileMap.
+// Cada tracker solo lee la dirección de su celda (O(1)), costo independiente del num de enemies.
+// El BFS corre en un worker thread sobre un snapshot del IntGrid. Cada recompute es un BFS completo (O(tiles)),
+// no incremental: lo que se evita es recomputar cuando nada cambió. Triple buffer: el worker escribe back, lo deja
+// en ready, y el main thread lo adopta como front una vez por tick (publish); sample/matches/getDistance leen
+// front sin lock (hot path del AI), porque solo publish lo cambia.
+class FlowField {
+public:
+    FlowField();
+    ~FlowField();
+    FlowField(const FlowField&) = delete;
+    FlowField& operator=(const FlowField&) = delete;
+
+    // Main thread, una vez por tick antes del AI: publica el último field terminado por el worker (si hay).
+    // Después encola recompute solo si el goal cambió de tile o el tilemap cambió (revision/dims).
+    // Con isDeterministic() calcula en el acto (replays)
+    void requestIfChanged(const TileMap& tilemap, Vector2 goalWorld);
+    void publish();  // Solo el swap ready -> front (requestIfChanged ya lo llama)
+
+    // Dirección normalizada hacia el goal desde worldPos; false si no hay field o celda inalcanzable
+    bool sample(Vector2 worldPos, Vector2& outDir) const;
+
+    // true si el field publicado corresponde al estado actual del tilemap
+    bool matches(const TileMap& tilemap) const;
+
+    int getDistance(int tx, int ty) const;  // -1 = inalcanzable/sin field
+    uint64_t getGeneration() const;         // Num de fields publicados (para debug/editor)
+
+private:
+    static constexpr int8_t kNoDir = -1;
+
+    struct Field {
+        int width = 0, height = 0;
+        float tileWorld = 1.0f;
+        unsigned int revision = 0;
+        std::vector<int32_t> dist;  // Pasos BFS hasta el goal
+        std::vector<int8_t> dir;    // Índice a vecino (8 dirs) o kNoDir
+    };
+
+    struct Job {
+        int width = 0, height = 0;
+        float tileWorld = 1.0f;
+        unsigned int revision = 0;
+        int goalX = 0, goalY = 0;
+        std::vector<uint8_t> solid;  // Snapshot compacto del IntGrid
+    };
+
+    // Estado de la última request (main thread)
+    int lastGoalX = -1, lastGoalY = -1;
+    int lastWidth = 0, lastHeight = 0;
+    unsigned int lastRevision = 0;
+    bool hasRequest = false;
+
+    Field front;  // Leído sin lock; solo lo cambia publish (main thread)
+    Field ready;  // Último field terminado, esperando publish (bajo mutex)
+    Field back;   // Escrito por worker
+    Job pending;
+    Job working;
+    std::vector<int32_t> workerQueue;  // Cola del BFS reusada entre recomputes (worker)
+    std::vector<int32_t> syncQueue;    // Idem, camino determinista (main thread)
+    bool jobReady = false;
+    bool fieldReady = false;
+    bool quit = false;
+    std::atomic<uint64_t> generation{0};
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::thread worker;
+
+    void workerLoop();
+    static void compute(const Job& job, Field& out, std::vector<int32_t>& queue);
+};
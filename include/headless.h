@@ -0,0 +1,42 @@
+// include/headless.h
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Runner sin ventana: setup de una escena y N ticks a dt fijo, midiendo solo la simulación.
+// Para máquinas de build/soak sin display.
+
+struct HeadlessConfig {
+    std::string scene = "Adventure";
+    int ticks = 600;
+    float dt = 1.0f / 60.0f;
+    int width = 800, height = 600;  // Tamaño "virtual" de pantalla que reciben las escenas
+    bool wander = true;             // Script de teclas (flechas) para que el player explore y expanda el mapa
+    int warmupTicks = 120;          // Ticks excluidos de las stats de allocations (caches, reservas)
+    int allocBudget = -1;           // Máx allocations por tick tras warmup; -1 = sin chequeo
+    std::string recordPath;         // Graba input + seed + hash por tick (replay.h)
+    std::string replayPath;         // Reproduce un archivo: escena/ticks/dt/input salen de ahí, verifica hashes
+};
+
+struct HeadlessReport {
+    bool ok = false;
+    int ticks = 0;
+    double setupMs = 0.0;
+    double totalMs = 0.0;  // Suma de ticks (sin setup)
+    double avgMs = 0.0, p50Ms = 0.0, p95Ms = 0.0, p99Ms = 0.0, maxMs = 0.0;
+    size_t entities = 0;   // Entities con Position al final del run
+
+    // Allocations por tick después de warmupTicks
+    double avgAllocs = 0.0;
+    uint64_t maxAllocs = 0;
+    int maxAllocsTick = -1;
+    bool budgetExceeded = false;
+
+    // Replay: primer tick cuyo hash no coincide con el grabado (-1 = idéntico)
+    int divergedTick = -1;
+    uint32_t finalHash = 0;
+};
+
+HeadlessReport runHeadless(HeadlessConfig& config);  // Con replayPath, config toma escena/ticks/dt del archivo
+void printHeadlessReport(const HeadlessConfig& config, const HeadlessReport& report);
@@ -0,0 +1,80 @@
+// include/hpa.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <utility>
+#include "ecs.h"
+#include "components.h"
+
+// Pathfinding jerárquico (HPA*) sobre los chunks del TileMap.
+// Grafo abstracto = entradas en los bordes entre chunks + costos intra-chunk precalculados.
+// sync() solo reconstruye los chunks cuyo contenido cambió (y sus vecinos, que comparten borde).
+class ChunkPathfinder {
+public:
+    // Barato si nada cambió (compara revision); si cambió, firma por chunk y rebuild parcial
+    void sync(const TileMap& tilemap);
+
+    // Ruta en world space (centros de tile, solo puntos donde cambia la dirección).
+    // false si no hay camino o el grafo no está construido
+    bool findPath(Vector2 fromWorld, Vector2 toWorld, std::vector<Vector2>& out);
+
+    // Tile caminable más cercano (búsqueda en anillos hasta maxRadius tiles)
+    bool nearestWalkable(Vector2 world, int maxRadius, Vector2& out) const;
+
+    size_t getNodeCount() const { return nodeCount; }
+    size_t getLastRebuiltChunks() const { return lastRebuilt; }
+    size_t getRouteCacheHits() const { return cacheHits; }
+
+private:
+    struct Node {
+        int tile;      // Índice global del tile
+        int8_t side;   // 0=N, 1=E, 2=S, 3=W
+        int16_t run;   // Índice de la entrada dentro de ese borde
+    };
+
+    struct Chunk {
+        uint64_t signature = 0;
+        std::vector<Node> nodes;
+        int sideStart[5] = {0, 0, 0, 0, 0};  // nodes[sideStart[s]..sideStart[s+1]) están en el lado s
+        std::vector<int> cost;               // n x n, -1 = sin camino dentro del chunk
+        std::unordered_map<uint32_t, std::vector<int>> pathCache;  // (a<<16|b) -> tiles intra-chunk
+    };
+
+    int width = 0, height = 0, chunkSize = 0;
+    int chunksX = 0, chunksY = 0;
+    float tileWorld = 1.0f;
+    unsigned int revision = 0;
+    bool built = false;
+
+    std::vector<uint8_t> solid;  // Copia compacta del IntGrid
+    std::vector<Chunk> chunks;
+    std::vector<int> nodeBase;   // Id global del primer nodo de cada chunk
+    size_t nodeCount = 0;
+    size_t lastRebuilt = 0;
+    size_t cacheHits = 0;
+
+    // Ruta abstracta cacheada por (start chunk, goal chunk)
+    std::unordered_map<uint64_t, std::vector<int>> routeCache;
+
+    // Scratch reusado entre queries
+    std::vector<int> startDist, startParent, goalDist, goalParent, localDist, localParent;
+    std::vector<int> gScore, cameFrom;
+    std::vector<std::pair<int, int>> openHeap;
+    std::vector<uint32_t> visitStamp;
+    uint32_t stamp = 0;
+
+    bool isSolid(int x, int y) const;
+    int chunkOf(int tile) const;
+    void chunkBounds(int chunk, int& x0, int& y0, int& x1, int& y1) const;
+    uint64_t computeSignature(int chunk) const;
+    void rebuildChunk(int chunk);
+    void bfsChunk(int chunk, int fromTile, std::vector<int>& dist, std::vector<int>& parent) const;
+    int localIndex(int chunk, int tile) const;
+    int ownerChunk(int nodeId) const;
+    const std::vector<int>& intraPath(int chunk, int a, int b);
+    bool searchAbstract(int startTile, int goalTile, std::vector<int>& route);
+    void appendLocal(int chunk, const std::vector<int>& parent, int fromTile, int toTile, bool towardRoot, std::vector<int>& tiles) const;
+    void toWaypoints(const std::vector<int>& tiles, std::vector<Vector2>& out) const;
+};
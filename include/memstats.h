@@ -0,0 +1,57 @@
+// include/memstats.h
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "ecs.h"
+#include "components.h"
+
+// Telemetría de memoria: operator new/delete contados (global y por thread), bytes por component pool,
+// memoria del TileMap y de texturas. El conteo por system sale de las zonas del profiler.
+
+struct AllocCounters {
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t bytesAllocated = 0;  // Acumulado (pedido a operator new)
+    int64_t liveBytes = 0;        // Vivos ahora (tamaño usable de malloc)
+};
+
+// operator new/delete reemplazados en src/allochooks.cpp, que solo compilan GAME y GAME_bench con
+// GAME_ALLOC_HOOKS=ON (el engine no cambia el allocator de quien lo linkee). Sin hooks los contadores quedan en 0
+void memstatsNoteAlloc(std::size_t requested, void* p);
+void memstatsNoteFree(void* p);
+void memstatsSetHooksInstalled();
+bool allocHooksInstalled();
+
+AllocCounters allocCounters();  // Todos los threads
+uint64_t threadAllocCount();    // Solo el thread actual (atribución a zonas sin ruido de workers)
+
+// Allocations por frame (main thread + workers): llamar 1 vez por frame/tick
+struct FrameAllocStats {
+    static constexpr int kHistory = 240;
+    float history[kHistory] = {};  // Allocs por frame (ring)
+    uint64_t last = 0;
+    uint64_t lastBytes = 0;
+    uint64_t max = 0;              // Máximo en la ventana
+    float avg = 0.0f;
+};
+void memstatsEndFrame();
+const FrameAllocStats& frameAllocStats();
+
+struct ComponentMemory {
+    const char* name;
+    size_t count;
+    size_t bytes;  // Nodos + buckets del unordered_map + heap propio del component (vectors, maps)
+};
+
+struct MemoryReport {
+    std::vector<ComponentMemory> components;
+    size_t componentBytes = 0;
+    size_t tileCount = 0;
+    size_t tileMapBytes = 0;  // capacity de tiles (reserve a maxWidth*maxHeight incluido)
+    int textureCount = 0;
+    size_t textureBytes = 0;  // Tamaño de pixels de texturas vivas (headless: las decodificadas como metadata)
+    AllocCounters allocs;
+};
+
+void collectMemoryReport(ECS& ecs, MemoryReport& out);
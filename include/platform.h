@@ -0,0 +1,44 @@
+// include/platform.h
+#pragma once
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+
+// Capa mínima sobre raylib para poder correr las escenas sin ventana ni contexto GL (headless).
+// Las escenas/systems cargan texturas y leen input por aquí en vez de llamar a raylib directo.
+
+void setHeadless(bool headless);
+bool isHeadless();
+
+// Con ventana: LoadTexture. Headless: handle solo con metadata (id=0, width/height/format del archivo),
+// suficiente para hitboxes/frameRecs. Si el archivo no existe, width=height=0 en ambos modos
+Texture2D loadTexture(const char* path);
+void unloadTexture(Texture2D texture);  // Handles headless (id=0) solo descuentan la telemetría
+// Textura RGBA8 de width x height con un color (placeholder del AssetManager); updateTexture le sube los pixels
+// reales sin cambiar el id. Headless: solo metadata
+Texture2D createTexture(int width, int height, Color color);
+void updateTexture(Texture2D texture, const void* pixels);
+void updateTextureRect(Texture2D texture, Rectangle rect, const void* pixels);  // Sub-rect (pixels de rect.width x rect.height)
+// Copia en CPU (RGBA8) de los pixels de una textura, leída de GPU. Headless o sin textura: Image vacía (data = nullptr)
+Image readTexture(Texture2D texture);
+inline bool textureLoaded(const Texture2D& texture) { return texture.width > 0; }
+int textureStats(size_t& bytes);  // Texturas vivas y bytes de pixels (telemetría de memoria)
+
+// Input: con ventana lee raylib; headless lee el stub (lo escribe el runner, e.g. un script de teclas)
+bool inputKeyDown(int key);
+bool inputKeyPressed(int key);
+void setStubKey(int key, bool down);
+bool stubKeyDown(int key);
+void setStubInput(bool stub);  // true: la sim lee el stub también con ventana (grabación de replays)
+void advanceStubInput();  // Fin de tick: current -> previous (para flancos de inputKeyPressed)
+
+// RNG por thread (xoshiro128**) en lugar de GetRandomValue/SetRandomSeed, que comparten un estado global:
+// una escena se puede generar en un worker sin pisar el RNG del main thread. El estado se puede mover
+// entre threads (la escena precargada lo trae al main thread al activarse: misma secuencia que un setup síncrono)
+struct RandomState {
+    uint32_t s[4];
+};
+void setRandomSeed(unsigned int seed);
+int randomValue(int min, int max);  // [min, max], como GetRandomValue
+RandomState getRandomState();
+void setRandomState(const RandomState& state);
@@ -0,0 +1,43 @@
+// include/pool.h
+#pragma once
+#include <vector>
+#include <tuple>
+#include <unordered_map>
+#include "ecs.h"
+#include "components.h"
+
+// Pool de enemies: al despawnear, los nodos de cada component salen de sus maps (extract) y quedan
+// estacionados aquí; al spawnear se reinsertan y se resetean in place. Sin new/delete en steady state.
+// PatrolRoute solo la llevan los Patrol: al despawnear su nodo va a un stock aparte (attachRoute)
+class EnemyPool {
+public:
+    int maxLive = 400;  // Cap global de enemies vivos (todos los spawners)
+
+    // Entity reciclada (components ya restaurados, valores viejos) o -1 si el pool está vacío
+    Entity acquire(ECS& ecs);
+    // Estaciona la entity: deja de existir para todos los systems hasta el próximo acquire
+    void release(ECS& ecs, Entity e);
+
+    void noteCreated() { ++live; }  // Enemy nuevo (no reciclado) que cuenta para maxLive
+    void reserve(size_t n) { parked.reserve(n); spareRoutes.reserve(n); }
+    // PatrolRoute de e: la que tenga, un nodo del stock (con su bloque del arena, valores viejos) o una nueva
+    PatrolRoute& attachRoute(ECS& ecs, Entity e);
+
+    int getLive() const { return live; }
+    size_t getParked() const { return parked.size(); }
+    size_t getRecycled() const { return recycled; }
+
+private:
+    template<typename... Ts>
+    struct Parked {
+        Entity id = (Entity)-1;
+        std::tuple<typename std::unordered_map<Entity, Ts>::node_type...> nodes;
+    };
+    // Components que lleva un enemy spawneado (ver validEnemyPrefab)
+    using ParkedEnemy = Parked<Position, Velocity, Size, Sprite, Animation, MovementPattern, SpawnedBy>;
+
+    std::vector<ParkedEnemy> parked;
+    std::vector<std::unordered_map<Entity, PatrolRoute>::node_type> spareRoutes;
+    int live = 0;
+    size_t recycled = 0;
+};
@@ -0,0 +1,113 @@
+// include/prefab.h
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <typeindex>
+#include "ecs.h"
+#include "components.h"
+
+// Prefab: template con nombre = set de components con valores default.
+// ecs.instantiate(prefab, N, initFn) reserva una vez en cada map y construye N entities contiguas.
+
+struct PrefabComponentBase {
+    virtual ~PrefabComponentBase() = default;
+    virtual void reserve(ECS& ecs, size_t extra) const = 0;
+    virtual void addRange(ECS& ecs, Entity first, size_t count) const = 0;
+    virtual std::unique_ptr<PrefabComponentBase> clone() const = 0;
+};
+
+template<typename T>
+struct PrefabComponent : PrefabComponentBase {
+    T value;
+    explicit PrefabComponent(T v) : value(std::move(v)) {}
+
+    void reserve(ECS& ecs, size_t extra) const override {
+        auto& map = ecs.getComponentMap<T>();
+        map.reserve(map.size() + extra);
+    }
+    void addRange(ECS& ecs, Entity first, size_t count) const override {
+        // Component-major: un solo map caliente a la vez
+        auto& map = ecs.getComponentMap<T>();
+        EntityIndex& index = ecs.getEntityIndex();
+        for (size_t i = 0; i < count; ++i) {
+            if (map.insert_or_assign(first + i, value).second) index.add(first + i, componentBit<T>);
+        }
+    }
+    std::unique_ptr<PrefabComponentBase> clone() const override {
+        return std::make_unique<PrefabComponent<T>>(value);
+    }
+};
+
+class Prefab {
+public:
+    std::string name;
+
+    Prefab() = default;
+    explicit Prefab(std::string n) : name(std::move(n)) {}
+    Prefab(const Prefab& other) : name(other.name) {
+        for (auto& [type, comp] : other.components) components.push_back({type, comp->clone()});
+    }
+    Prefab& operator=(const Prefab& other) {
+        if (this != &other) *this = Prefab(other);
+        return *this;
+    }
+    Prefab(Prefab&&) = default;
+    Prefab& operator=(Prefab&&) = default;
+
+    // Agrega o reemplaza el default de T
+    template<typename T>
+    Prefab& with(T value) {
+        if (T* existing = get<T>()) *existing = std::move(value);
+        else components.push_back({std::type_index(typeid(T)), std::make_unique<PrefabComponent<T>>(std::move(value))});
+        return *this;
+    }
+
+    // Para ajustar defaults desde código (e.g., texturas cargadas en runtime)
+    template<typename T>
+    T* get() {
+        for (auto& [type, comp] : components) {
+            if (type == std::type_index(typeid(T))) return &static_cast<PrefabComponent<T>*>(comp.get())->value;
+        }
+        return nullptr;
+    }
+    template<typename T>
+    const T* get() const { return const_cast<Prefab*>(this)->get<T>(); }
+
+    const std::vector<std::pair<std::type_index, std::unique_ptr<PrefabComponentBase>>>& getComponents() const { return components; }
+
+private:
+    std::vector<std::pair<std::type_index, std::unique_ptr<PrefabComponentBase>>> components;
+};
+
+// Registro de prefabs por nombre, opcionalmente cargados de un archivo de datos (ver assets/prefabs.txt)
+class PrefabLibrary {
+public:
+    Prefab& add(const std::string& name);
+    Prefab* find(const std::string& name);
+
+    // Formato: secciones [nombre] con líneas "Component = valores" o "Component.campo = valor".
+    // Merge sobre prefabs ya registrados (código puede completar texturas/animaciones después)
+    bool loadFile(const std::string& path);
+
+private:
+    std::unordered_map<std::string, Prefab> prefabs;
+};
+
+template<typename InitFn>
+Entity ECS::instantiate(const Prefab& prefab, size_t count, InitFn&& initFn) {
+    Entity first = createEntities(count);
+    if (count == 0) return first;
+    for (auto& [type, comp] : prefab.getComponents()) {
+        comp->reserve(*this, count);
+        comp->addRange(*this, first, count);
+    }
+    for (size_t i = 0; i < count; ++i) initFn(first + i, i);
+    return first;
+}
+
+inline Entity ECS::instantiate(const Prefab& prefab, size_t count) {
+    return instantiate(prefab, count, [](Entity, size_t) {});
+}
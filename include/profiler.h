@@ -0,0 +1,128 @@
+// include/profiler.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <memory>
+
+// Profiler por zonas: PROFILE_ZONE("nombre") mide el scope actual con el TSC (rdtsc) y lo guarda en un
+// buffer por thread. PROFILE_FRAME_END() (main thread, 1 vez por frame) junta los buffers, actualiza
+// stats rodantes por zona y, si hay captura activa, acumula eventos para exportar a Chrome trace.
+// Sin GAME_PROFILE las macros se expanden a nada: cero costo en builds sin instrumentación.
+
+struct ProfileEvent {
+    const char* name;   // Literal (vive todo el programa)
+    uint64_t start;     // Ticks TSC
+    uint64_t end;
+    uint16_t depth;     // Anidamiento dentro del thread
+    uint16_t thread;    // Índice del buffer (0 = primer thread registrado, normalmente el main)
+    uint32_t allocs;    // operator new del thread dentro de la zona (incluye zonas hijas)
+};
+
+uint64_t threadAllocCount();  // src/memstats.cpp
+
+struct ProfileZoneStats {
+    const char* name = nullptr;
+    static constexpr int kHistory = 240;  // Frames de ventana rodante
+    float history[kHistory] = {};         // ms por frame (suma de todas las llamadas del frame)
+    int calls = 0;                        // Llamadas en el último frame
+    int allocs = 0;                       // Allocations en el último frame
+    float avgAllocs = 0.0f;
+    float allocHistory[kHistory] = {};
+    float minMs = 0.0f, avgMs = 0.0f, p99Ms = 0.0f, lastMs = 0.0f;
+};
+
+class Profiler {
+public:
+    static Profiler& instance();
+
+    static uint64_t now();  // Ticks TSC (o ns de steady_clock si no hay TSC)
+    void record(const char* name, uint64_t start, uint64_t end, uint16_t depth, uint32_t allocs);
+    void endFrame();
+
+    // Datos del último frame cerrado (para la timeline del Editor)
+    const std::vector<ProfileEvent>& getLastFrame() const { return lastFrame; }
+    uint64_t getLastFrameStart() const { return lastFrameStart; }
+    uint64_t getLastFrameEnd() const { return lastFrameEnd; }
+    const std::vector<ProfileZoneStats>& getZones() const { return zones; }
+    const std::vector<float>& getFrameTimes() const { return frameTimes; }  // ms, orden cronológico
+    double ticksToMs(uint64_t ticks) const { return ticks * nsPerTick * 1e-6; }
+    int getThreadCount() const;
+
+    // Captura para Chrome trace (chrome://tracing o ui.perfetto.dev)
+    void startCapture(int frames);
+    bool isCapturing() const { return captureFramesLeft > 0; }
+    size_t getCapturedEvents() const { return captured.size(); }
+    bool exportChromeTrace(const std::string& path) const;
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;  // Sin contención salvo en endFrame
+        std::vector<ProfileEvent> events;
+        uint16_t index = 0;
+        bool inUse = true;  // false al terminar su thread: lo reusa el próximo (threads de gen de chunks)
+    };
+
+    Profiler();
+    ThreadBuffer& threadBuffer();
+
+    mutable std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    std::vector<ProfileEvent> lastFrame;
+    std::vector<ProfileEvent> scratch;
+    uint64_t lastFrameStart = 0, lastFrameEnd = 0;
+
+    std::vector<ProfileZoneStats> zones;
+    std::vector<float> frameTimes;
+    static constexpr size_t kFrameHistory = 300;
+    int frameIndex = 0;
+
+    std::vector<ProfileEvent> captured;
+    int captureFramesLeft = 0;
+    uint64_t captureOrigin = 0;
+
+    // Calibración TSC -> ns (se refina en cada endFrame contra steady_clock)
+    double nsPerTick = 1.0;
+    uint64_t calibTicks0 = 0;
+    int64_t calibNs0 = 0;
+
+    ProfileZoneStats& zoneFor(const char* name);
+    void calibrate();
+};
+
+// Zona RAII: mide desde el constructor hasta el fin del scope
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name(name), start(Profiler::now()), allocs0(threadAllocCount()) {
+        depth = currentDepth()++;
+    }
+    ~ProfileZone() {
+        --currentDepth();
+        uint64_t end = Profiler::now();
+        Profiler::instance().record(name, start, end, depth, (uint32_t)(threadAllocCount() - allocs0));
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+    uint64_t allocs0;
+    uint16_t depth;
+    static uint16_t& currentDepth() {
+        thread_local uint16_t depth = 0;
+        return depth;
+    }
+};
+
+#ifdef GAME_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_FRAME_END() Profiler::instance().endFrame()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FRAME_END()
+#endif
@@ -0,0 +1,158 @@
+// include/renderqueue.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// Render frontend: los systems (tilemap, sprites, overlays, HUD) no llaman a raylib, escriben comandos
+// compactos con sort key en CommandBuffers. RenderQueue::flush (main thread, el único que toca GL) junta
+// los buffers, los ordena con radix sort por layer/depth/textura y los reproduce en un solo backend.
+// Los comandos capturan todo lo que necesitan (posición interpolada, id de textura): generar la lista
+// no depende del estado de raylib, así que puede correr en workers (parallelFor).
+
+// Orden de dibujo entre layers. Los layers < Hud van en world space (dentro de la cámara de la queue)
+enum class RenderLayer : uint8_t { Tiles, Sprites, DebugWorld, Hud };
+
+enum class RenderCommandType : uint8_t { Quad, Rect, Text, Lines, Triangles };
+
+struct QuadCommand {
+    Rectangle src;
+    Rectangle dst;
+};
+struct TextCommand {
+    int x, y;
+    int fontSize;
+    uint32_t offset;  // En el arena de texto del CommandBuffer (null-terminated)
+};
+struct GeometryCommand {
+    const Vector2* vertices;  // Del productor: tienen que vivir hasta flush (draw lists cacheados)
+    uint32_t count;
+    float lineWidth;  // Solo Lines
+};
+
+struct RenderCommand {
+    RenderCommandType type;
+    Color color;
+    uint16_t texWidth = 0, texHeight = 0;  // Quad: para normalizar UVs (DrawTexturePro)
+    uint32_t texture = 0;                  // Quad: id GL
+    union {
+        QuadCommand quad;
+        Rectangle rect;
+        TextCommand text;
+        GeometryCommand geometry;
+    };
+    RenderCommand() : quad{} {}
+};
+
+// Layer (8 bits) | depth (32) | textura (24): dentro del layer manda depth (mayor = encima) y a igual depth
+// se agrupa por textura. El sort es estable: a igual key, orden de submit
+inline uint64_t makeSortKey(RenderLayer layer, uint32_t texture, uint32_t depth) {
+    return ((uint64_t)layer << 56) | ((uint64_t)depth << 24) | (texture & 0xFFFFFFu);
+}
+
+// Depth para y-sort (sprites): más abajo en el mundo = encima. Bits del float con orden de uint (negativos incluidos)
+inline uint32_t depthFromY(float y) {
+    uint32_t bits;
+    std::memcpy(&bits, &y, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+// Comandos de un productor (un thread a la vez). clear() conserva la capacidad: sin allocations en steady state
+class CommandBuffer {
+public:
+    void quad(RenderLayer layer, const Texture2D& texture, Rectangle src, Rectangle dst, Color tint, uint32_t depth = 0);
+    void rect(RenderLayer layer, Rectangle dst, Color color, uint32_t depth = 0);
+    void text(RenderLayer layer, const char* str, int x, int y, int fontSize, Color color, uint32_t depth = 0);
+    void lines(RenderLayer layer, const Vector2* vertices, uint32_t count, float lineWidth, Color color, uint32_t depth = 0);
+    void triangles(RenderLayer layer, const Vector2* vertices, uint32_t count, Color color, uint32_t depth = 0);
+
+    void clear();
+    size_t size() const { return commands.size(); }
+
+private:
+    friend class RenderQueue;
+    std::vector<uint64_t> keys;  // Paralelo a commands (el merge solo lee keys)
+    std::vector<RenderCommand> commands;
+    std::vector<char> textArena;
+
+    RenderCommand& push(RenderLayer layer, uint32_t texture, uint32_t depth);
+};
+
+struct RenderQueueStats {
+    int commands = 0;
+    int segments = 0;        // CommandBuffers con comandos en el frame
+    int parallelRanges = 0;  // Rangos generados por parallelFor (incluye los del main thread)
+    int textureSwitches = 0; // Cambios de textura en el replay (después del sort)
+    int sortPasses = 0;      // Pasadas de radix sort hechas (las de un solo bucket se saltan)
+};
+
+class RenderQueue {
+public:
+    RenderQueue() = default;
+    ~RenderQueue();
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Inicio de frame: vacía los buffers y la cámara
+    void beginFrame();
+    // Cámara para los layers world space (sin cámara: coordenadas de pantalla)
+    void setCamera(const Camera2D& cam);
+    bool hasCamera() const { return cameraSet; }
+    const Camera2D& getCamera() const { return camera; }
+
+    // Buffer para submits del main thread. Sigue a los segmentos de parallelFor anteriores: a igual key,
+    // el replay respeta el orden de submit entre llamadas
+    CommandBuffer& main() { return *segments[mainSegment()]; }
+
+    // fn(buffer, begin, end) sobre [0, count) en rangos de >= grain items, cada rango en su propio
+    // CommandBuffer (workers + main thread). Bloquea hasta terminar; el merge va en orden de rango, así que
+    // el resultado es el mismo que generarlo serial. fn solo puede leer estado compartido
+    using RangeFn = std::function<void(CommandBuffer& buffer, size_t begin, size_t end)>;
+    void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+    // Main thread, con GL: sort + replay. Los comandos quedan hasta el próximo beginFrame
+    void flush();
+    void sort();  // Solo merge + radix sort, sin GL (flush lo llama; headless/bench)
+
+    const RenderQueueStats& getStats() const { return stats; }
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t segment;
+        uint32_t index;
+    };
+
+    std::vector<std::unique_ptr<CommandBuffer>> segments;
+    size_t usedSegments = 0;  // Segmentos del frame (el último es el de main())
+    std::vector<SortEntry> entries;
+    std::vector<SortEntry> scratch;
+    Camera2D camera = {};
+    bool cameraSet = false;
+    RenderQueueStats stats;
+
+    // Workers (arrancan en el primer parallelFor)
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workCv;  // Hay rangos sin tomar / quit
+    std::condition_variable doneCv;  // Terminó el último rango
+    const RangeFn* task = nullptr;
+    size_t taskCount = 0, taskRanges = 0, taskBase = 0;
+    size_t nextRange = 0, pendingRanges = 0;
+    bool quit = false;
+
+    size_t mainSegment();
+    size_t addSegment();
+    void startWorkers();
+    void workerLoop();
+    void runRange(size_t range);
+    void sortEntries();
+    void replay();
+};
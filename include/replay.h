@@ -0,0 +1,44 @@
+// include/replay.h
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ecs.h"
+#include "components.h"
+
+// Grabación de input por tick + seed en un archivo compacto, y replay determinista.
+// Tras cada tick se encadena un hash del estado del ECS: si un build (o un cambio de threads)
+// diverge, el replay lo detecta en el tick exacto. Sirve también como workload reproducible para perf.
+
+// Seed de la sesión (las escenas la usan en vez de time(NULL)). Sin setSessionSeed se toma del reloj una vez
+void setSessionSeed(uint32_t seed);
+uint32_t sessionSeed();
+
+// Grabando/reproduciendo: el trabajo asíncrono (flow field) se publica dentro del mismo tick,
+// así el resultado no depende del scheduling de los workers
+void setDeterministic(bool deterministic);
+bool isDeterministic();
+
+struct Replay {
+    std::string scene;
+    uint32_t seed = 0;
+    float dt = 1.0f / 60.0f;
+    int width = 800, height = 600;
+    std::vector<uint16_t> input;   // Bitmask de kReplayKeys por tick (en disco: runs de ticks iguales)
+    std::vector<uint32_t> hashes;  // Hash encadenado tras cada tick
+};
+
+bool saveReplay(const std::string& path, const Replay& replay);
+bool loadReplay(const std::string& path, Replay& replay);
+
+// Input del tick <-> stub de platform (solo las teclas que lee la simulación)
+uint16_t stubInputMask();
+void applyInputMask(uint16_t mask);
+void latchLiveInput();  // Con ventana: raylib -> stub al inicio de cada tick grabado
+
+// Hash del estado simulado; independiente del orden de iteración de los component maps
+uint64_t hashState(ECS& ecs);
+inline uint64_t chainHash(uint64_t rolling, uint64_t state) {
+    uint64_t h = (rolling ^ state) * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
@@ -4,29 +4,66 @@
 #include "../components.h"
 #include "../systems.h"
 #include "../perlin.h"  // Nuevo: Para PerlinNoise
+#include "../flowfield.h"
+#include "../hpa.h"
+#include "../ailod.h"
+#include "../culling.h"
+#include "../debugoverlay.h"
+#include "../chunksummary.h"
+#include "../pool.h"
+#include "../prefab.h"
+#include "../assets.h"
 #include <mutex>  // Para std::mutex
+#include <string>
+#include <unordered_map>
 
 class AdventureScene : public Scene {
 public:
     AdventureScene(int width, int height);
-    void setup() override;
+    void beginLoad() override;
+    void load(LoadProgress& progress) override;
     void update(float dt) override;
-    void render() override;
+    void render(RenderQueue& queue) override;
     void clean() override;
     bool debugSpawners = true;
+    AILodScheduler aiLod;  // Público para tunear/ver stats desde el Editor
+    SpriteCuller spriteCuller;  // Stats de culling en el Editor
+    SpawnerOverlay spawnerOverlay;  // Debug spawners: draw list cacheado
+    ChunkSummaries chunkSummaries;  // LOD del tilemap con zoom alejado + minimapa
+    bool showMinimap = true;
     
 
 private:
     int screen_width, screen_height;
     Entity player, enemy;
+    Entity tilemapEnt = -1, cameraEnt = -1;
     PerlinNoise perlin;
 
     // Nuevo: Parámetros para procedural gen (accesibles en métodos)
-    float frequency = 0.03f;
-    float thresholdWall = 0.65f;
-    float thresholdHazard = 0.2f;
+    ChunkGenParams genParams;  // frequency 0.03, wall > 0.65, hazard < 0.2
+    float expansionCooldown = 0.0f;  // Check de expansión cada 0.2s (por escena: reproducible en replays)
     
 
+    // Broadphase para player-enemy (rebuild por frame)
+    SpatialGrid enemyGrid{128.0f, 4096};
+
+    // Flow field compartido por todos los Tracking (BFS en worker thread)
+    FlowField flowField;
+
+    // HPA* por chunks: patrullas y spawns con rutas válidas
+    ChunkPathfinder pathfinder;
+
+    // Enemies de spawners: cap global + reciclaje al despawnear
+    EnemyPool enemyPool;
+
+    PrefabLibrary prefabs;  // enemy_tracking / enemy_circular / enemy_patrol / enemy_spawned
+    const Prefab* spawnPrefab = nullptr;  // enemy_spawned (nodo estable del map)
+
+    TextureHandle atlas;  // Mago + tileset + specials (AssetManager, se suelta en clean())
+    Texture2D atlasTex{};  // Copiados en beginLoad: load() corre en un worker y no toca el AssetManager
+    std::unordered_map<std::string, Rectangle> atlasRegions;
+    unsigned int seed = 0;
+
     // Nuevo: Mutex para safe thread access a tiles
     std::mutex tileMutex;
 
@@ -3,13 +3,16 @@
 #include "../Scene.h"
 #include "../components.h"
 #include "../systems.h"
+#include "../breakout.h"
+#include <string>
 
 class BreakoutScene : public Scene {
 public:
-    BreakoutScene(int width, int height);
-    void setup() override;
+    // levelPath: ver assets/levels/breakout.txt; si no abre, layout por defecto de 4x2
+    BreakoutScene(int width, int height, std::string levelPath = "assets/levels/breakout.txt");
+    void load(LoadProgress& progress) override;
     void update(float dt) override;
-    void render() override;
+    void render(RenderQueue& queue) override;
     void clean() override;
 
 private:
@@ -17,5 +20,7 @@ private:
     int screen_height;
     bool isRunning = true;
     Entity paddle;
-    Entity ball;
+    std::string levelPath;
+    Entity level;  // BlockGrid + BallSet
+    BreakoutStepStats stepStats;
 };
\ No newline at end of file
@@ -5,10 +5,11 @@
 class MenuScene : public Scene {
 public:
     MenuScene();
-    void setup() override;
+    void load(LoadProgress& progress) override;
     void update(float dt) override;
-    void render() override;
+    void render(RenderQueue& queue) override;
     void clean() override;
 
     bool startGame = false;  // Flag para switch a Breakout
+    bool startStress = false;  // S: StressScene (medición de escalado)
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+// include/scenes/StressScene.h
+#pragma once
+#include "../Scene.h"
+#include "../components.h"
+#include "../systems.h"
+#include "../flowfield.h"
+#include "../pool.h"
+#include "../culling.h"
+#include "../chunksummary.h"
+#include "../aibatch.h"
+#include "../prefab.h"
+#include "../assets.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+// Escena de carga: counts configurables (sliders en el Editor) para medir cómo escala cada subsystem
+struct StressConfig {
+    int sprites = 2000;    // Solo Position + Sprite + Animation (render/animación)
+    int tracking = 500;    // MovementPattern por tipo (AI + movement)
+    int circular = 500;
+    int patrol = 500;
+    int spawners = 8;
+    int mapChunks = 10;    // Mapa de mapChunks x mapChunks chunks (solo en setup)
+    bool ramp = false;     // Multiplica todos los counts por rampFactor cada rampInterval
+    float rampInterval = 2.0f;
+    float rampFactor = 1.5f;
+    int rampMax = 200000;  // Corta la rampa al pasar este total
+};
+
+// Un punto de la curva: promedio de los frames con el mismo set de counts
+struct StressSample {
+    int entities = 0;
+    int frames = 0;
+    float simMs = 0, aiMs = 0, movementMs = 0, animationMs = 0, spawnMs = 0, renderMs = 0;
+};
+
+class StressScene : public Scene {
+public:
+    StressScene(int width, int height);
+    void beginLoad() override;
+    void load(LoadProgress& progress) override;
+    void update(float dt) override;
+    void render(RenderQueue& queue) override;
+    void clean() override;
+
+    StressConfig config;  // Público: sliders del Editor
+    SpriteCuller spriteCuller;
+    ChunkSummaries chunkSummaries;  // LOD del tilemap con zoom alejado
+    AIBatch aiBatch;  // systemAI particionado por MovementType
+
+    const std::vector<StressSample>& getCurve() const { return curve; }
+    const StressSample& getCurrent() const { return current; }
+    int getEntityCount() const;
+    void clearCurve() { curve.clear(); }
+
+private:
+    int screen_width, screen_height;
+    Entity player = -1, camera = -1, tilemapEnt = -1;
+
+    enum Group { Sprites, Tracking, Circular, Patrol, Spawners, GroupCount };
+    std::vector<Entity> groups[GroupCount];
+    std::vector<int> walkableTiles;  // Índices de tiles caminables (posiciones de spawn)
+    TextureHandle atlas;  // Mago + tileset (AssetManager, se suelta en clean())
+    Texture2D atlasTex{};  // Copiados en beginLoad (load corre en un worker)
+    std::unordered_map<std::string, Rectangle> atlasRegions;
+
+    FlowField flowField;
+    EnemyPool enemyPool;
+    PrefabLibrary prefabs;
+    const Prefab* spawnPrefab = nullptr;  // stress_spawned
+
+    StressSample current;             // Acumulando (sumas; se promedia al cerrar)
+    std::vector<StressSample> curve;  // Frame time vs count
+    float rampTimer = 0.0f;
+    float reportTimer = 0.0f;
+    float lastRenderMs = 0.0f;
+
+    void applyCounts();  // Crea/quita entities hasta igualar config
+    void resize(Group group, int target);
+    void closeSample();  // Cierra el punto actual de la curva y lo imprime
+    Vector2 randomWalkablePos();
+};
@@ -0,0 +1,107 @@
+// include/simdmath.h
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <bit>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Math para kernels batched (AIBatch): cada función SSE2 (4 lanes) tiene su gemela escalar con las mismas
+// operaciones en el mismo orden, así el resultado es bit a bit igual por cualquiera de los dos caminos
+// (systemAI batched vs updateMovementPattern del AI LOD, replays entre builds con y sin SSE2).
+
+inline constexpr float kTwoPi = 6.28318530717958647692f;
+inline constexpr float kInvTwoPi = 0.15915494309189533577f;
+
+// sincos de Cephes (reducción a octantes + polinomios de grado 7/8, error ~1e-7 en [-8192, 8192])
+inline constexpr float kFourOverPi = 1.27323954473516f;
+inline constexpr float kDP1 = -0.78515625f;
+inline constexpr float kDP2 = -2.4187564849853515625e-4f;
+inline constexpr float kDP3 = -3.77489497744594108e-8f;
+inline constexpr float kSin0 = -1.9515295891e-4f, kSin1 = 8.3321608736e-3f, kSin2 = -1.6666654611e-1f;
+inline constexpr float kCos0 = 2.443315711809948e-5f, kCos1 = -1.388731625493765e-3f, kCos2 = 4.166664568298827e-2f;
+
+// a - 2π·floor(a / 2π): ángulos acumulados sin perder precisión con el tiempo
+inline float wrapTwoPi(float a) {
+    return a - floorf(a * kInvTwoPi) * kTwoPi;
+}
+
+// Normaliza (x, y) in place como Vector2Normalize (multiplica por 1/len) y devuelve len; (0, 0) queda igual
+inline float normalize2(float& x, float& y) {
+    const float len = sqrtf(x * x + y * y);
+    if (len > 0) {
+        const float inv = 1.0f / len;
+        x = x * inv;
+        y = y * inv;
+    }
+    return len;
+}
+
+inline void sinCosApprox(float x, float& s, float& c) {
+    uint32_t signSin = std::bit_cast<uint32_t>(x) & 0x80000000u;
+    x = fabsf(x);
+    int j = (int)(x * kFourOverPi);
+    j = (j + 1) & ~1;
+    float y = (float)j;
+    const uint32_t swapSin = (uint32_t)(j & 4) << 29;
+    const uint32_t signCos = (uint32_t)(~(j - 2) & 4) << 29;
+    const bool sinPoly = (j & 2) == 0;
+    x = ((x + y * kDP1) + y * kDP2) + y * kDP3;
+    signSin ^= swapSin;
+
+    const float z = x * x;
+    float yc = ((kCos0 * z + kCos1) * z + kCos2) * z * z;
+    yc = yc - z * 0.5f;
+    yc = yc + 1.0f;
+    float ys = ((kSin0 * z + kSin1) * z + kSin2) * z * x + x;
+
+    s = std::bit_cast<float>(std::bit_cast<uint32_t>(sinPoly ? ys : yc) ^ signSin);
+    c = std::bit_cast<float>(std::bit_cast<uint32_t>(sinPoly ? yc : ys) ^ signCos);
+}
+
+#if defined(__SSE2__)
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 floor4(__m128 v) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.0f)));
+}
+
+inline __m128 wrapTwoPi4(__m128 a) {
+    return _mm_sub_ps(a, _mm_mul_ps(floor4(_mm_mul_ps(a, _mm_set1_ps(kInvTwoPi))), _mm_set1_ps(kTwoPi)));
+}
+
+inline void sinCos4(__m128 x, __m128& s, __m128& c) {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    __m128 signSin = _mm_and_ps(x, signMask);
+    x = _mm_andnot_ps(signMask, x);
+
+    __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(kFourOverPi)));
+    j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(j);
+    const __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+    const __m128 signCos = _mm_castsi128_ps(
+        _mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    const __m128 sinPoly = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP1)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP2)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP3)));
+    signSin = _mm_xor_ps(signSin, swapSin);
+
+    const __m128 z = _mm_mul_ps(x, x);
+    __m128 yc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kCos0), z), _mm_set1_ps(kCos1));
+    yc = _mm_add_ps(_mm_mul_ps(yc, z), _mm_set1_ps(kCos2));
+    yc = _mm_mul_ps(_mm_mul_ps(yc, z), z);
+    yc = _mm_sub_ps(yc, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    yc = _mm_add_ps(yc, _mm_set1_ps(1.0f));
+    __m128 ys = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kSin0), z), _mm_set1_ps(kSin1));
+    ys = _mm_add_ps(_mm_mul_ps(ys, z), _mm_set1_ps(kSin2));
+    ys = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ys, z), x), x);
+
+    s = _mm_xor_ps(select4(sinPoly, ys, yc), signSin);
+    c = _mm_xor_ps(select4(sinPoly, yc, ys), signCos);
+}
+#endif
@@ -0,0 +1,68 @@
+// include/spatial.h
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "ecs.h"
+#include "components.h"
+
+// Broadphase: grid uniforme hasheado (mundo "infinito", sin bounds fijos).
+// Se reconstruye cada frame con counting sort -> layout plano, cero allocs en steady state.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 64.0f, uint32_t bucketCount = 4096);
+
+    void clear();
+    void insert(Entity e, Rectangle box);  // Acumula; llamar build() después
+    void build();                          // Ordena items por bucket (counting sort)
+
+    // Rebuild completo desde Position + Size (todas las entidades con ambos)
+    void rebuild(ECS& ecs);
+
+    // Rebuild solo con entidades que tengan el component Tag (e.g., MovementPattern)
+    template<typename Tag>
+    void rebuildFrom(ECS& ecs) {
+        clear();
+        for (auto& [e, _] : ecs.getComponentMap<Tag>()) {
+            auto* pos = ecs.getComponent<Position>(e);
+            auto* size = ecs.getComponent<Size>(e);
+            if (!pos || !size) continue;
+            insert(e, {pos->pos.x, pos->pos.y, size->w, size->h});
+        }
+        build();
+    }
+
+    // Queries: out se limpia y se llena sin duplicados
+    void queryAABB(Rectangle box, std::vector<Entity>& out);
+    void queryRadius(Vector2 center, float radius, std::vector<Entity>& out);
+    void queryPairs(std::vector<std::pair<Entity, Entity>>& out);
+
+    size_t size() const { return ids.size(); }
+    float getCellSize() const { return cellSize; }
+
+private:
+    float cellSize;
+    float invCellSize;
+    uint32_t bucketMask;  // bucketCount es potencia de 2
+
+    // SoA de items insertados
+    std::vector<Entity> ids;
+    std::vector<Rectangle> boxes;
+
+    // Buckets: cellStart[b]..cellStart[b+1] indexa cellItems
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellItems;
+    std::vector<std::pair<uint32_t, uint32_t>> entries;  // (bucket, item) temporal del build
+
+    // Dedup de queries (item visto en el query actual si stamp == queryStamp)
+    std::vector<uint32_t> stamp;
+    uint32_t queryStamp = 0;
+
+    int cellCoord(float v) const;
+    uint32_t bucketOf(int cx, int cy) const;
+    uint32_t nextStamp();
+
+    template<typename Fn>
+    void forEachCandidate(Rectangle box, Fn&& fn);
+};
@@ -3,32 +3,71 @@
 #pragma once
 #include "ecs.h"
 #include "components.h"
+#include "spatial.h"
+#include "collision.h"
+#include "renderqueue.h"
 #include <raylib.h>
 
-bool checkCollision(const Position& aPos, const Size& aSize, const Position& bPos, const Size& bSize);
-
 void systemPaddleControl(ECS& ecs, float dt, int screenWidth);
-void systemBallMovement(ECS& ecs, float dt, int screenWidth, int screenHeight, bool& isRunning);
-void systemBallPaddleCollision(ECS& ecs);
-void systemBallBlockCollision(ECS& ecs);
-void systemRender(ECS& ecs);
+// Balls y bloques de Breakout: breakout.h (BlockGrid + BallSet, sin entities)
+// Los systems de render no dibujan: escriben comandos en la RenderQueue (la reproduce Game::render)
+void systemRender(ECS& ecs, RenderQueue& queue, float alpha = 1.0f);
+
+// Fixed timestep: snapshot de Position/cam antes de cada tick; render interpola con alpha [0,1]
+void systemSnapshotPositions(ECS& ecs);
+Vector2 interpolatedPosition(const Position& pos, float alpha);
+Camera2D interpolatedCamera(const CameraComp& camComp, float alpha);
 
 
 void systemInput(ECS& ecs);
-void systemAI(ECS& ecs, float dt);  // Mantiene, pero ahora maneja MovementPattern
-void systemMovement(ECS& ecs, float dt);
+class FlowField;
+class AIBatch;
+// Tracking sigue el flow field si se pasa; con batch, kernels por MovementType (aibatch.h)
+void systemAI(ECS& ecs, float dt, const FlowField* flow = nullptr, AIBatch* batch = nullptr);
+void updateMovementPattern(ECS& ecs, Entity entity, MovementPattern& pattern, float dt, const FlowField* flow, const TileMap* tilemap);
+// Patrol hot <- cold: count y waypoint cacheado desde la ruta (conserva current si sigue en rango). Llamar tras tocar route.points
+void syncPatrolRoute(MovementPattern& pattern, const PatrolRoute& route);
+// Llegó al waypoint: pasa al siguiente (lee la ruta). false = ruta sin loop terminada (frenar)
+bool advancePatrol(PatrolParams& patrol, const PatrolRoute* route);
+void systemMovement(ECS& ecs, float dt);  // Sweep contra TileMap con sliding por eje
 void systemAnimationUpdate(ECS& ecs, float dt);
-void systemRenderSprites(ECS& ecs);
+class SpriteCuller;
+// Con culler: solo lo visible por la cámara, generado en paralelo (queue.parallelFor)
+void systemRenderSprites(ECS& ecs, RenderQueue& queue, float alpha = 1.0f, SpriteCuller* culler = nullptr);
 
 // Para Tilemaps e IntGrid
 void systemAutoTiling(ECS& ecs);
-void systemRenderTileMap(ECS& ecs);
+class ChunkSummaries;
+// Tiles visibles por filas en paralelo; con summaries (ya sincronizados) y zoom alejado, un quad por chunk
+void systemRenderTileMap(ECS& ecs, RenderQueue& queue, ChunkSummaries* summaries = nullptr);
+// Textura y sub-rect con que se dibuja un tile (special o tileset)
+Rectangle tileSource(const TileMap& tilemap, const Tile& tile, Texture2D& texture);
 void systemTileInteractions(ECS& ecs, float dt);  // Aplica effects (damage, pickup)
-void systemDebugIntGrid(ECS& ecs);
+class IntGridOverlay;
+void systemDebugIntGrid(ECS& ecs, IntGridOverlay& overlay, RenderQueue& queue, Rectangle view);  // Textura por chunk, culled a view
 
 void systemCameraUpdate(ECS& ecs, float dt);  // Actualiza cam target
 void systemRenderWithCamera(ECS& ecs);  // No needed—wrap en scene render
 void systemAutoTilingChunk(ECS& ecs, int startX, int startY, int endX, int endY);
 
-void systemEnemySpawn(ECS& ecs, float dt);
-void systemDebugSpawners(ECS& ecs);  // Para overlays de zonas
\ No newline at end of file
+// Gen procedural de un chunk (IntGrid por umbrales de Perlin + pickups random)
+class PerlinNoise;
+struct ChunkGenParams {
+    float frequency = 0.03f;
+    float thresholdWall = 0.65f;
+    float thresholdHazard = 0.2f;
+};
+void generateChunkTiles(TileMap& tilemap, int offsetX, int offsetY, PerlinNoise& perlin, const ChunkGenParams& params);
+
+class ChunkPathfinder;
+class EnemyPool;
+// enemy: prefab armado en la carga de la escena con Position, Velocity, Size, Sprite, Animation, MovementPattern y
+// SpawnedBy (el pattern y el tint se sortean por spawn). Cada wave sale del pool y lo que falte en un instantiate.
+// Con paths: spawns fuera de muros y patrullas ruteadas
+bool validEnemyPrefab(const Prefab& enemy);
+void systemEnemySpawn(ECS& ecs, float dt, const Prefab& enemy, ChunkPathfinder* paths = nullptr, EnemyPool* pool = nullptr);
+bool buildPatrolRoute(ChunkPathfinder& paths, const std::vector<Vector2>& stops, Vector2 centerOffset, WaypointList& out);
+class SpawnerOverlay;
+void systemDebugSpawners(ECS& ecs, SpawnerOverlay& overlay, RenderQueue& queue, Rectangle view);  // Draw list cacheado de zonas
+
+void systemContactDamage(ECS& ecs, SpatialGrid& grid, float dt, float damagePerSecond = 20.0f);
\ No newline at end of file
@@ -0,0 +1,67 @@
+// include/waypoints.h
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+
+// Lista de waypoints con small buffer: hasta kInline puntos viven dentro del component (sin heap, que es el
+// caso de casi todas las patrullas); las rutas largas (HPA multi-chunk) piden un bloque al arena compartido.
+// API tipo std::vector para lo que usan las patrullas. clear() conserva el bloque (reuso en el EnemyPool)
+class WaypointList {
+public:
+    static constexpr uint32_t kInline = 8;
+
+    WaypointList() = default;
+    WaypointList(std::initializer_list<Vector2> points) { assign(points.begin(), points.end()); }
+    WaypointList(const WaypointList& other) { assign(other.begin(), other.end()); }
+    WaypointList(WaypointList&& other) noexcept { steal(other); }
+    WaypointList& operator=(const WaypointList& other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    WaypointList& operator=(WaypointList&& other) noexcept;
+    WaypointList& operator=(std::initializer_list<Vector2> points) {
+        assign(points.begin(), points.end());
+        return *this;
+    }
+    ~WaypointList() { release(); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return cap; }
+    bool isInline() const { return heap == nullptr; }
+
+    Vector2* data() { return heap ? heap : inlinePoints; }
+    const Vector2* data() const { return heap ? heap : inlinePoints; }
+    Vector2& operator[](size_t i) { return data()[i]; }
+    const Vector2& operator[](size_t i) const { return data()[i]; }
+    Vector2* begin() { return data(); }
+    Vector2* end() { return data() + count; }
+    const Vector2* begin() const { return data(); }
+    const Vector2* end() const { return data() + count; }
+    Vector2& back() { return data()[count - 1]; }
+
+    void clear() { count = 0; }
+    void reserve(size_t n);
+    void push_back(Vector2 p);
+    void assign(const Vector2* first, const Vector2* last);
+
+private:
+    Vector2* heap = nullptr;  // Bloque del arena (nullptr = inline)
+    uint32_t count = 0;
+    uint32_t cap = kInline;
+    Vector2 inlinePoints[kInline];
+
+    void steal(WaypointList& other);
+    void release();
+};
+
+// Arena compartido para el overflow: bloques de potencia de 2 (>= 16 puntos) cortados de slabs y reciclados
+// por free list de su clase. Thread-safe (la carga de escenas en background también arma rutas)
+struct WaypointArenaStats {
+    size_t reservedBytes = 0;  // Slabs pedidos al sistema
+    size_t usedBytes = 0;      // Bloques entregados a WaypointLists vivas
+    size_t blocks = 0;
+};
+WaypointArenaStats waypointArenaStats();
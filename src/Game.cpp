@@ -2,6 +2,11 @@
 #include "Game.h"
 #include <iostream>
 #include "print.h"
+#include "profiler.h"
+#include "memstats.h"
+#include "platform.h"
+#include "assets.h"
+#include "culling.h"
 #include <rlImGui.h>
 
 Game::Game(const char* title, int width, int height) 
@@ -10,78 +15,181 @@ Game::Game(const char* title, int width, int height)
     SetTargetFPS(60);
     rlImGuiSetup(true);
 
-    
+    // Indicador default: barra abajo al centro; la escena actual sigue dibujándose detrás
+    loadingIndicator = [this](const std::string& scene, float progress) {
+        const int w = screen_width / 2, h = 16;
+        const int x = (screen_width - w) / 2, y = screen_height - 60;
+        DrawRectangle(x, y, w, h, Fade(BLACK, 0.6f));
+        DrawRectangle(x, y, (int)(w * progress), h, SKYBLUE);
+        DrawRectangleLines(x, y, w, h, WHITE);
+        DrawText(TextFormat("Loading %s... %d%%", scene.c_str(), (int)(progress * 100.0f)), x, y - 24, 20, DARKGRAY);
+    };
+
     switchScene("Menu");
 }
 
-Game::~Game() {}
+Game::~Game() {
+    if (pending && pending->loader.joinable()) pending->loader.join();
+}
 
 void Game::setup() {
     
     if (currentScene) currentScene->setup();
 }
 
-void Game::frame_start() {}
+void Game::frame_start() {
+    AssetManager::instance().pumpUploads();  // Texturas decodificadas en workers -> GPU (batch por frame)
+    pollPreload();
+}
 
 void Game::handle_events() {}
 
 void Game::update(float dt) {
     if (paused) return;
+    if (!currentScene) return;
+    PROFILE_ZONE("Game::update");
 
-    if (currentScene) {
-        currentScene->update(dt);
+    // Un hitch largo (debugger, carga) no debe convertirse en cientos de ticks
+    accumulator += dt > 0.25f ? 0.25f : dt;
 
+    int steps = 0;
+    while (accumulator >= fixedDt && steps < maxStepsPerFrame) {
+        PROFILE_ZONE("Game::tick");
+        if (!recordPath.empty()) {
+            latchLiveInput();  // La sim lee el stub: exactamente lo que queda grabado
+            recording.input.push_back(stubInputMask());
+        }
+        systemSnapshotPositions(currentScene->getECS());
+        currentScene->update(fixedDt);
+        accumulator -= fixedDt;
+        ++steps;
+        if (!recordPath.empty()) {
+            recordHash = chainHash(recordHash, hashState(currentScene->getECS()));
+            recording.hashes.push_back((uint32_t)recordHash);
+            advanceStubInput();
+        }
 
-        
         if (auto* menu = dynamic_cast<MenuScene*>(currentScene.get())) {
-            if (menu->startGame) {
-                switchScene("Adventure");
+            if ((menu->startGame || menu->startStress) && !pending) {
+                preloadScene(menu->startStress ? "Stress" : "Adventure");
+                if (!pending) break;  // Carga síncrona: la escena ya cambió
             }
         }
-        
     }
+    // Si se alcanzó el límite, descarta el tiempo sobrante (la sim va más lenta en vez de colgarse)
+    if (steps == maxStepsPerFrame && accumulator >= fixedDt) accumulator = 0.0f;
+
+    currentScene->renderAlpha = accumulator / fixedDt;
 }
 
-void Game::render() {
-    BeginDrawing();
-    ClearBackground(BLACK);
+void Game::setTickRate(float hz) {
+    if (hz <= 0.0f) {
+        std::cerr << "Invalid tick rate: " << hz << std::endl;
+        return;
+    }
+    fixedDt = 1.0f / hz;
+    accumulator = 0.0f;
+}
+
+void Game::setRenderRate(int fps) {
+    SetTargetFPS(fps);
+}
+
+void Game::startRecording(const std::string& path) {
+    recordPath = path;
+    setStubInput(true);
+    setDeterministic(true);
+    // La escena actual ya hizo setup con la seed de la sesión: la grabación arranca desde su primer tick
+    beginRecording();
+}
+
+void Game::beginRecording() {
+    recording = Replay{};
+    recording.scene = currentSceneName;
+    recording.seed = sessionSeed();
+    recording.dt = fixedDt;
+    recording.width = screen_width;
+    recording.height = screen_height;
+    recordHash = 0;
+    applyInputMask(0);  // Mismo estado inicial del stub que un replay headless
+    advanceStubInput();
+}
+
+void Game::finishRecording() {
+    if (recording.input.empty()) return;
+    // Cada cambio de escena cierra un segmento: run.rpl, run.1-Adventure.rpl, ... (no pisa los anteriores)
+    std::string path = recordPath;
+    if (recordSegment > 0) {
+        const size_t slash = path.find_last_of("/\\");
+        const size_t dot = path.find_last_of('.');
+        const size_t stem = (dot != std::string::npos && (slash == std::string::npos || dot > slash)) ? dot : path.size();
+        path.insert(stem, "." + std::to_string(recordSegment) + "-" + recording.scene);
+    }
+    ++recordSegment;
+    if (saveReplay(path, recording)) {
+        std::cout << "Replay saved: " << path << " (" << recording.scene << ", " << recording.input.size() << " ticks)" << std::endl;
+    }
+}
 
-    if (currentScene) currentScene->render();
+void Game::render() {
+    PROFILE_ZONE("Game::render");
+    renderQueue.beginFrame();
+    {
+        PROFILE_ZONE("Scene::render");  // Frontend: la escena solo escribe comandos
+        if (currentScene) currentScene->render(renderQueue);
+    }
 
-    // Nuevo: Debug IntGrid (wrap en camera si existe)
-    if (editor.debugIntGrid) {
+    // Debug IntGrid: texturas por chunk (se re-suben solo si cambian tiles), culled a la cámara si existe
+    if (editor.debugIntGrid && currentScene) {
         auto& ecs = currentScene->getECS();
-        // Encuentra la camera entity (asumiendo solo una—puedes iterar si múltiples)
-        CameraComp* camComp = nullptr;
-        for (auto& [ent, comp] : ecs.getComponentMap<CameraComp>()) {
-            camComp = &comp;
-            break;  // Toma la primera
-        }
-        if (camComp) {
-            BeginMode2D(camComp->cam);
-        }
-        systemDebugIntGrid(ecs);
-        if (camComp) {
-            EndMode2D();
+        auto& cameras = ecs.getComponentMap<CameraComp>();
+        if (!cameras.empty()) {
+            Camera2D cam = interpolatedCamera(cameras.begin()->second, currentScene->renderAlpha);
+            if (!renderQueue.hasCamera()) renderQueue.setCamera(cam);
+            systemDebugIntGrid(ecs, intGridOverlay, renderQueue, cameraViewRect(cam));
+        } else {
+            systemDebugIntGrid(ecs, intGridOverlay, renderQueue, {0, 0, (float)screen_width, (float)screen_height});
         }
     }
 
+    // Backend: un solo replay ordenado. Lo que sigue (indicador, FPS, ImGui) va encima, inmediato
+    BeginDrawing();
+    ClearBackground(BLACK);
+    renderQueue.flush();
+
+    if (pending && loadingIndicator) loadingIndicator(pending->name, pending->progress.get());
+
     DrawFPS(10, 10);
 
-    rlImGuiBegin();
-    editor.renderGUI(currentScene.get());
-    rlImGuiEnd();
+    {
+        PROFILE_ZONE("Editor::renderGUI");
+        rlImGuiBegin();
+        editor.renderGUI(currentScene.get(), &renderQueue);
+        rlImGuiEnd();
+    }
 
+    PROFILE_ZONE("EndDrawing");  // Incluye swap/espera de vsync
     EndDrawing();
 }
 
-void Game::frame_end() {}
+void Game::frame_end() {
+    PROFILE_FRAME_END();
+    memstatsEndFrame();
+}
 
 void Game::clean() {
     if (cleaned) return;
     cleaned = true;
 
+    if (pending) {
+        // El worker no se puede cortar: se espera y se descarta la escena a medio activar
+        pending->loader.join();
+        pending->scene->clean();
+        pending.reset();
+    }
     if (currentScene) currentScene->clean();
+    if (!recordPath.empty()) finishRecording();
+    intGridOverlay.clear();  // Texturas: antes de cerrar el contexto GL
 
     rlImGuiShutdown();
     CloseWindow();
@@ -92,17 +200,60 @@ bool Game::running() {
 }
 
 void Game::switchScene(const std::string& sceneName) {
-    if (currentScene) currentScene->clean();
+    std::unique_ptr<Scene> next = createScene(sceneName, screen_width, screen_height);
+    if (!next) return;
 
-    if (sceneName == "Menu") {
-        currentScene = std::make_unique<MenuScene>();
-    } else if (sceneName == "Adventure") {
-        currentScene = std::make_unique<AdventureScene>(screen_width, screen_height);
-    } else {
-        std::cerr << "Unknown scene: " << sceneName << std::endl;
+    LoadProgress progress;
+    next->beginLoad();
+    next->load(progress);
+    activateScene(std::move(next), sceneName);
+}
+
+void Game::preloadScene(const std::string& sceneName) {
+    if (pending) return;  // Una precarga a la vez
+    if (isDeterministic()) {
+        // El orden de la carga respecto a los ticks cambiaría el replay
+        switchScene(sceneName);
         return;
     }
+    std::unique_ptr<Scene> next = createScene(sceneName, screen_width, screen_height);
+    if (!next) return;
+
+    pending = std::make_unique<PendingScene>();
+    pending->scene = std::move(next);
+    pending->name = sceneName;
+    pending->scene->beginLoad();
+    PendingScene* job = pending.get();
+    job->loader = std::thread([job] {
+        job->scene->load(job->progress);
+        job->rng = getRandomState();
+        job->done.store(true, std::memory_order_release);
+    });
+}
+
+void Game::setLoadingIndicator(std::function<void(const std::string& scene, float progress)> indicator) {
+    loadingIndicator = std::move(indicator);
+}
+
+void Game::pollPreload() {
+    if (!pending || !pending->done.load(std::memory_order_acquire)) return;
+    PROFILE_ZONE("Game::activateScene");
+    pending->loader.join();
+    setRandomState(pending->rng);  // Mismo estado que tras un setup síncrono
+    std::unique_ptr<Scene> next = std::move(pending->scene);
+    std::string name = pending->name;
+    pending.reset();
+    activateScene(std::move(next), name);
+}
+
+void Game::activateScene(std::unique_ptr<Scene> next, const std::string& sceneName) {
+    if (currentScene) currentScene->clean();
+    currentScene = std::move(next);
+    if (!recordPath.empty()) finishRecording();
 
     currentSceneName = sceneName;
-    currentScene->setup();
-}
\ No newline at end of file
+    intGridOverlay.clear();  // Cache del tilemap de la escena anterior
+    currentScene->activate();
+    accumulator = 0.0f;
+    if (!recordPath.empty()) beginRecording();
+}
@@ -0,0 +1,291 @@
+// src/aibatch.cpp
+#include "aibatch.h"
+#include "systems.h"
+#include "flowfield.h"
+#include "profiler.h"
+#include "simdmath.h"
+#include <algorithm>
+#include <cmath>
+
+void AIBatch::Columns::resize(size_t n) {
+    for (auto* v : {&px, &py, &vx, &vy, &tx, &ty, &speed, &a, &b}) v->resize(n);
+    mask.resize(n);
+    entry.resize(n);
+}
+
+void AIBatch::rebuild(ECS& ecs) {
+    PROFILE_ZONE("AIBatch::rebuild");
+    for (auto& lane : lanes) lane.clear();
+    for (auto& [entity, pattern] : ecs.getComponentMap<MovementPattern>()) {
+        if (pattern.type == MovementType::None) continue;
+        auto* pos = ecs.getComponent<Position>(entity);
+        auto* vel = ecs.getComponent<Velocity>(entity);
+        if (!pos || !vel) continue;
+        Entry entry{entity, &pattern, pos, vel, ecs.getComponent<Animation>(entity), ecs.getComponent<Size>(entity)};
+        if (pattern.type == MovementType::Patrol) entry.route = ecs.getComponent<PatrolRoute>(entity);
+        lanes[(int)pattern.type - 1].push_back(entry);
+    }
+    // Orden estable por entity (el del hash map depende de los buckets)
+    for (auto& lane : lanes)
+        std::sort(lane.begin(), lane.end(), [](const Entry& l, const Entry& r) { return l.entity < r.entity; });
+
+    dirty = false;
+    const EntityIndex& index = ecs.getEntityIndex();
+    indexOwner = &index;
+    indexVersion = index.version;
+    rebuilds++;
+}
+
+void AIBatch::update(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap) {
+    PROFILE_ZONE("AIBatch::update");
+    const EntityIndex& index = ecs.getEntityIndex();
+    if (dirty || indexOwner != &index || indexVersion != index.version) rebuild(ecs);
+
+    runTracking(ecs, dt, flow, tilemap);
+    runCircular(ecs, dt, flow, tilemap);
+    runPatrol(ecs, dt, flow, tilemap);
+}
+
+Position* AIBatch::resolveTarget(ECS& ecs, Entry& entry) {
+    // El puntero cacheado es válido mientras no haya bajas (rebuild); solo cambia si cambia el target
+    if (entry.target != entry.pattern->target) {
+        entry.target = entry.pattern->target;
+        entry.targetPos = entry.target == (Entity)-1 ? nullptr : ecs.getComponent<Position>(entry.target);
+    }
+    return entry.targetPos;
+}
+
+bool AIBatch::typeChanged(ECS& ecs, Entry& entry, MovementType expected, float dt, const FlowField* flow, const TileMap* tilemap) {
+    if (entry.pattern->type == expected) return false;
+    updateMovementPattern(ecs, entry.entity, *entry.pattern, dt, flow, tilemap);
+    dirty = true;
+    return true;
+}
+
+// --- Tracking: px,py = pos | tx,ty = target (-> dir) | vx,vy = vel | a = lerpFactor | b = pursuitDistance | mask = lejos ---
+
+static inline void trackingDir(float px, float py, float& tx, float& ty, float pursuit, uint32_t& far) {
+    float dx = tx - px, dy = ty - py;
+    float dist = normalize2(dx, dy);
+    far = (pursuit > 0 && dist > pursuit) ? ~0u : 0u;
+    tx = dx;
+    ty = dy;
+}
+
+static inline void trackingVel(float& vx, float& vy, float dx, float dy, float speed, float lerp, uint32_t far) {
+    float desiredX = dx * speed, desiredY = dy * speed;
+    vx = far ? 0.0f : vx + lerp * (desiredX - vx);  // Como Vector2Lerp
+    vy = far ? 0.0f : vy + lerp * (desiredY - vy);
+}
+
+void AIBatch::runTracking(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap) {
+    PROFILE_ZONE("AIBatch::tracking");
+    auto& lane = lanes[(int)MovementType::Tracking - 1];
+    cols.resize(lane.size());
+    size_t n = 0;
+    for (uint32_t i = 0; i < lane.size(); ++i) {
+        Entry& e = lane[i];
+        if (typeChanged(ecs, e, MovementType::Tracking, dt, flow, tilemap)) continue;
+        Position* target = resolveTarget(ecs, e);
+        if (!target) continue;
+        cols.entry[n] = i;
+        cols.px[n] = e.pos->pos.x;
+        cols.py[n] = e.pos->pos.y;
+        cols.tx[n] = target->pos.x;
+        cols.ty[n] = target->pos.y;
+        cols.vx[n] = e.vel->vel.x;
+        cols.vy[n] = e.vel->vel.y;
+        cols.speed[n] = e.pattern->speed;
+        cols.a[n] = e.pattern->tracking.lerpFactor;
+        cols.b[n] = e.pattern->tracking.pursuitDistance;
+        ++n;
+    }
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&cols.tx[i]), _mm_loadu_ps(&cols.px[i]));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&cols.ty[i]), _mm_loadu_ps(&cols.py[i]));
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 pursuit = _mm_loadu_ps(&cols.b[i]);
+        __m128 far = _mm_and_ps(_mm_cmpgt_ps(pursuit, zero), _mm_cmpgt_ps(dist, pursuit));
+        __m128 nonZero = _mm_cmpgt_ps(dist, zero);
+        __m128 inv = _mm_div_ps(one, dist);
+        _mm_storeu_ps(&cols.tx[i], select4(nonZero, _mm_mul_ps(dx, inv), dx));
+        _mm_storeu_ps(&cols.ty[i], select4(nonZero, _mm_mul_ps(dy, inv), dy));
+        _mm_storeu_si128((__m128i*)&cols.mask[i], _mm_castps_si128(far));
+    }
+#endif
+    for (; i < n; ++i) trackingDir(cols.px[i], cols.py[i], cols.tx[i], cols.ty[i], cols.b[i], cols.mask[i]);
+
+    // Rodea muros siguiendo el flow field (sample O(1), escalar: es un lookup en tabla)
+    if (flow) {
+        for (i = 0; i < n; ++i) {
+            if (cols.mask[i]) continue;
+            const Entry& e = lane[cols.entry[i]];
+            Vector2 center = e.size ? Vector2{cols.px[i] + e.size->w / 2.0f, cols.py[i] + e.size->h / 2.0f}
+                                    : Vector2{cols.px[i] + 8.0f * tilemap->scale, cols.py[i] + 8.0f * tilemap->scale};
+            Vector2 flowDir;
+            if (flow->sample(center, flowDir)) {
+                cols.tx[i] = flowDir.x;
+                cols.ty[i] = flowDir.y;
+            }
+        }
+    }
+
+    i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= n; i += 4) {
+        __m128 speed = _mm_loadu_ps(&cols.speed[i]);
+        __m128 lerp = _mm_loadu_ps(&cols.a[i]);
+        __m128 far = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&cols.mask[i]));
+        __m128 vx = _mm_loadu_ps(&cols.vx[i]), vy = _mm_loadu_ps(&cols.vy[i]);
+        __m128 desiredX = _mm_mul_ps(_mm_loadu_ps(&cols.tx[i]), speed);
+        __m128 desiredY = _mm_mul_ps(_mm_loadu_ps(&cols.ty[i]), speed);
+        vx = _mm_add_ps(vx, _mm_mul_ps(lerp, _mm_sub_ps(desiredX, vx)));
+        vy = _mm_add_ps(vy, _mm_mul_ps(lerp, _mm_sub_ps(desiredY, vy)));
+        _mm_storeu_ps(&cols.vx[i], _mm_andnot_ps(far, vx));
+        _mm_storeu_ps(&cols.vy[i], _mm_andnot_ps(far, vy));
+    }
+#endif
+    for (; i < n; ++i) trackingVel(cols.vx[i], cols.vy[i], cols.tx[i], cols.ty[i], cols.speed[i], cols.a[i], cols.mask[i]);
+
+    for (i = 0; i < n; ++i) {
+        Entry& e = lane[cols.entry[i]];
+        e.vel->vel = {cols.vx[i], cols.vy[i]};
+        if (!e.anim) continue;
+        if (cols.mask[i]) e.anim->currentState = AnimState::Idle;
+        else if (fabs(cols.vx[i]) > fabs(cols.vy[i])) e.anim->currentState = (cols.vx[i] > 0) ? AnimState::WalkRight : AnimState::WalkLeft;
+        else e.anim->currentState = AnimState::Idle;
+    }
+}
+
+// --- Circular: tx,ty = centro | a = currentAngle | b = angularSpeed | speed = radius | salida en px,py,vx,vy ---
+
+static inline void circularStep(float cx, float cy, float& angle, float w, float r, float dt,
+                                float& px, float& py, float& vx, float& vy) {
+    angle = wrapTwoPi(angle + w * dt);
+    float s, c;
+    sinCosApprox(angle, s, c);
+    px = cx + r * c;
+    py = cy + r * s;
+    vx = -r * w * s;
+    vy = r * w * c;
+}
+
+void AIBatch::runCircular(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap) {
+    PROFILE_ZONE("AIBatch::circular");
+    auto& lane = lanes[(int)MovementType::Circular - 1];
+    cols.resize(lane.size());
+    size_t n = 0;
+    for (uint32_t i = 0; i < lane.size(); ++i) {
+        Entry& e = lane[i];
+        if (typeChanged(ecs, e, MovementType::Circular, dt, flow, tilemap)) continue;
+        const CircularParams& circular = e.pattern->circular;
+        Vector2 center = circular.center;
+        if (e.pattern->aroundTarget) {
+            if (Position* target = resolveTarget(ecs, e)) center = target->pos;
+        }
+        cols.entry[n] = i;
+        cols.tx[n] = center.x;
+        cols.ty[n] = center.y;
+        cols.a[n] = circular.currentAngle;
+        cols.b[n] = circular.angularSpeed;
+        cols.speed[n] = circular.radius;
+        ++n;
+    }
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    for (; i + 4 <= n; i += 4) {
+        __m128 w = _mm_loadu_ps(&cols.b[i]);
+        __m128 r = _mm_loadu_ps(&cols.speed[i]);
+        __m128 angle = wrapTwoPi4(_mm_add_ps(_mm_loadu_ps(&cols.a[i]), _mm_mul_ps(w, vdt)));
+        __m128 s, c;
+        sinCos4(angle, s, c);
+        _mm_storeu_ps(&cols.a[i], angle);
+        _mm_storeu_ps(&cols.px[i], _mm_add_ps(_mm_loadu_ps(&cols.tx[i]), _mm_mul_ps(r, c)));
+        _mm_storeu_ps(&cols.py[i], _mm_add_ps(_mm_loadu_ps(&cols.ty[i]), _mm_mul_ps(r, s)));
+        _mm_storeu_ps(&cols.vx[i], _mm_mul_ps(_mm_mul_ps(_mm_xor_ps(r, signMask), w), s));
+        _mm_storeu_ps(&cols.vy[i], _mm_mul_ps(_mm_mul_ps(r, w), c));
+    }
+#endif
+    for (; i < n; ++i) {
+        circularStep(cols.tx[i], cols.ty[i], cols.a[i], cols.b[i], cols.speed[i], dt, cols.px[i], cols.py[i], cols.vx[i], cols.vy[i]);
+    }
+
+    for (i = 0; i < n; ++i) {
+        Entry& e = lane[cols.entry[i]];
+        e.pattern->circular.currentAngle = cols.a[i];
+        e.pos->pos = {cols.px[i], cols.py[i]};
+        e.vel->vel = {cols.vx[i], cols.vy[i]};
+        if (e.anim) e.anim->currentState = AnimState::Idle;
+    }
+}
+
+// --- Patrol: px,py = pos | tx,ty = waypoint cacheado (PatrolParams) | speed | a = arrivalThreshold | salida vx,vy; mask = llegó ---
+
+static inline void patrolStep(float px, float py, float tx, float ty, float speed, float threshold,
+                              float& vx, float& vy, uint32_t& arrived) {
+    float dx = tx - px, dy = ty - py;
+    float dist = normalize2(dx, dy);
+    arrived = dist < threshold ? ~0u : 0u;
+    vx = dx * speed;
+    vy = dy * speed;
+}
+
+void AIBatch::runPatrol(ECS& ecs, float dt, const FlowField* flow, const TileMap* tilemap) {
+    PROFILE_ZONE("AIBatch::patrol");
+    auto& lane = lanes[(int)MovementType::Patrol - 1];
+    cols.resize(lane.size());
+    size_t n = 0;
+    for (uint32_t i = 0; i < lane.size(); ++i) {
+        Entry& e = lane[i];
+        if (typeChanged(ecs, e, MovementType::Patrol, dt, flow, tilemap)) continue;
+        const PatrolParams& patrol = e.pattern->patrol;
+        if (patrol.count == 0) continue;
+        cols.entry[n] = i;
+        cols.px[n] = e.pos->pos.x;
+        cols.py[n] = e.pos->pos.y;
+        cols.tx[n] = patrol.waypoint.x;
+        cols.ty[n] = patrol.waypoint.y;
+        cols.speed[n] = e.pattern->speed;
+        cols.a[n] = patrol.arrivalThreshold;
+        ++n;
+    }
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&cols.tx[i]), _mm_loadu_ps(&cols.px[i]));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&cols.ty[i]), _mm_loadu_ps(&cols.py[i]));
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 nonZero = _mm_cmpgt_ps(dist, zero);
+        __m128 inv = _mm_div_ps(one, dist);
+        __m128 speed = _mm_loadu_ps(&cols.speed[i]);
+        _mm_storeu_ps(&cols.vx[i], _mm_mul_ps(select4(nonZero, _mm_mul_ps(dx, inv), dx), speed));
+        _mm_storeu_ps(&cols.vy[i], _mm_mul_ps(select4(nonZero, _mm_mul_ps(dy, inv), dy), speed));
+        _mm_storeu_si128((__m128i*)&cols.mask[i], _mm_castps_si128(_mm_cmplt_ps(dist, _mm_loadu_ps(&cols.a[i]))));
+    }
+#endif
+    for (; i < n; ++i) {
+        patrolStep(cols.px[i], cols.py[i], cols.tx[i], cols.ty[i], cols.speed[i], cols.a[i], cols.vx[i], cols.vy[i], cols.mask[i]);
+    }
+
+    for (i = 0; i < n; ++i) {
+        Entry& e = lane[cols.entry[i]];
+        // Llegó: único acceso a la ruta (cold)
+        if (cols.mask[i] && !advancePatrol(e.pattern->patrol, e.route)) {
+            e.vel->vel = {0, 0};  // Stop si no loop
+            continue;
+        }
+        e.vel->vel = {cols.vx[i], cols.vy[i]};
+        if (e.anim) e.anim->currentState = (cols.vx[i] > 0) ? AnimState::WalkRight : AnimState::WalkLeft;
+    }
+}
@@ -0,0 +1,108 @@
+// src/ailod.cpp
+#include "ailod.h"
+#include "profiler.h"
+#include "systems.h"
+#include "flowfield.h"
+#include <chrono>
+#include <algorithm>
+
+void AILodScheduler::update(ECS& ecs, float dt, const FlowField* flow) {
+    PROFILE_ZONE("AILodScheduler::update");
+    ++frame;
+    stats = AILodStats{};
+    // Capacidad para todos en cualquier bucket: el reparto cambia con la cámara, realloc solo si hay más patterns
+    const size_t patterns = ecs.getComponentMap<MovementPattern>().size();
+    for (auto& b : buckets) {
+        b.clear();
+        b.reserve(patterns);
+    }
+    due.reserve(patterns);
+
+    // Cámara activa = la primera (como systemRenderTileMap). Sin cámara todo es Near
+    const CameraComp* camComp = nullptr;
+    for (auto& [camEnt, comp] : ecs.getComponentMap<CameraComp>()) {
+        camComp = &comp;
+        break;
+    }
+    const TileMap* tilemap = nullptr;
+    for (auto& [mapEnt, tm] : ecs.getComponentMap<TileMap>()) {
+        tilemap = &tm;
+        break;
+    }
+    if (flow && (!tilemap || !flow->matches(*tilemap))) flow = nullptr;
+
+    const float near2 = config.nearDistance * config.nearDistance;
+    const float mid2 = config.midDistance * config.midDistance;
+    const float dormant2 = config.dormantDistance * config.dormantDistance;
+
+    // Clasificación (distancia al cuadrado, sin sqrt)
+    for (auto& [entity, pattern] : ecs.getComponentMap<MovementPattern>()) {
+        AILodBucket bucket = AILodBucket::Near;
+        if (camComp) {
+            auto* pos = ecs.getComponent<Position>(entity);
+            if (!pos) continue;
+            float ddx = pos->pos.x - camComp->cam.target.x;
+            float ddy = pos->pos.y - camComp->cam.target.y;
+            float d2 = ddx * ddx + ddy * ddy;
+            if (d2 > dormant2) bucket = AILodBucket::Dormant;
+            else if (d2 > mid2) bucket = AILodBucket::Far;
+            else if (d2 > near2) bucket = AILodBucket::Mid;
+        }
+        buckets[(int)bucket].push_back({entity, &pattern});
+        stats.counts[(int)bucket]++;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const bool budgeted = config.maxDeferredUpdates > 0;
+    auto tick = [&](Entity entity, MovementPattern& pattern, int b) {
+        updateMovementPattern(ecs, entity, pattern, std::min(pattern.lodTimer, config.maxTickDt), flow, tilemap);
+        pattern.lodTimer = 0.0f;
+        stats.updated[b]++;
+    };
+
+    due.clear();
+    for (int b = 0; b < 3; ++b) {
+        auto t0 = Clock::now();
+        const int interval = (b == 0) ? 1 : std::max(1, (b == 1) ? config.midInterval : config.farInterval);
+
+        for (auto& [entity, pattern] : buckets[b]) {
+            pattern->lodTimer += dt;
+            // Shard: cada entity cae en un frame distinto del ciclo -> carga pareja. Los pospuestos por el
+            // budget siguen acumulando y compiten desde el frame siguiente (sin esperar su shard)
+            const bool deferredBefore = pattern->lodTimer > dt * (interval + 0.5f);  // Margen: suma de floats
+            if (interval > 1 && (frame + entity) % interval != 0 && !(budgeted && deferredBefore)) continue;
+            if (b > 0 && budgeted) {
+                due.push_back({entity, pattern, b});
+                continue;
+            }
+            tick(entity, *pattern, b);
+        }
+        stats.costMs[b] = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    if (!due.empty()) {
+        // Budget: los que más tiempo llevan sin tick primero. El orden del hash map es fijo entre frames: sin
+        // ranking ganarían siempre los mismos y el resto no correría nunca
+        const size_t take = std::min(due.size(), (size_t)config.maxDeferredUpdates);
+        if (take < due.size()) {
+            std::partial_sort(due.begin(), due.begin() + take, due.end(), [](const Due& a, const Due& b) {
+                if (a.pattern->lodTimer != b.pattern->lodTimer) return a.pattern->lodTimer > b.pattern->lodTimer;
+                return a.entity < b.entity;  // Desempate estable (replays)
+            });
+            stats.deferred = (int)(due.size() - take);
+        }
+        std::stable_partition(due.begin(), due.begin() + take, [](const Due& d) { return d.bucket == (int)AILodBucket::Mid; });
+        for (size_t i = 0; i < take;) {
+            const int b = due[i].bucket;
+            auto t0 = Clock::now();
+            for (; i < take && due[i].bucket == b; ++i) tick(due[i].entity, *due[i].pattern, b);
+            stats.costMs[b] += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        }
+    }
+
+    // Dormant: sin AI; frena para que no deriven con la última velocity
+    for (auto& [entity, pattern] : buckets[(int)AILodBucket::Dormant]) {
+        pattern->lodTimer = 0.0f;
+        if (auto* vel = ecs.getComponent<Velocity>(entity)) vel->vel = {0, 0};
+    }
+}
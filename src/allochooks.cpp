@@ -0,0 +1,25 @@
+// src/allochooks.cpp
+// Reemplazo global de operator new/delete para la telemetría de memstats. Fuera de GAME_engine: solo lo
+// compilan los ejecutables (GAME, GAME_bench) y solo con GAME_ALLOC_HOOKS
+#include "memstats.h"
+#include <cstdlib>
+#include <new>
+
+static const bool hooksRegistered = (memstatsSetHooksInstalled(), true);
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    memstatsNoteAlloc(size, p);
+    return p;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    memstatsNoteFree(p);
+    std::free(p);
+}
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
@@ -0,0 +1,255 @@
+// src/assets.cpp
+#include "assets.h"
+#include "platform.h"
+#include "profiler.h"
+#include "atlas.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+
+// Dimensiones desde el chunk IHDR (24 bytes), sin decodificar
+static bool readPngSize(const std::string& path, int& width, int& height) {
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    unsigned char header[24];
+    std::ifstream in(path, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+    if (memcmp(header, signature, sizeof(signature)) != 0 || memcmp(header + 12, "IHDR", 4) != 0) return false;
+    auto be32 = [](const unsigned char* b) { return (int)((uint32_t)b[0] << 24 | (uint32_t)b[1] << 16 | (uint32_t)b[2] << 8 | b[3]); };
+    width = be32(header + 16);
+    height = be32(header + 20);
+    return width > 0 && height > 0;
+}
+
+AssetManager& AssetManager::instance() {
+    static AssetManager manager;
+    return manager;
+}
+
+AssetManager::~AssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    jobCv.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    // Sin contexto GL a esta altura: solo se liberan las imágenes en CPU
+    for (Decoded& item : decoded) UnloadImage(item.image);
+    for (Decoded& item : toUpload) UnloadImage(item.image);
+}
+
+void AssetManager::startWorkers() {
+    if (!workers.empty()) return;
+    unsigned int count = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+    for (unsigned int i = 0; i < count; ++i) workers.emplace_back(&AssetManager::workerLoop, this);
+}
+
+void AssetManager::workerLoop() {
+    for (;;) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobCv.wait(lock, [this] { return quit || !jobs.empty(); });
+            if (quit) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        Image image = job.parts.empty() ? LoadImage(job.path.c_str()) : composeAtlas(job);
+        if (image.data) ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);  // Formato del placeholder
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decoded.push_back({job.slot, job.generation, image});
+        }
+        doneCv.notify_all();
+    }
+}
+
+uint32_t AssetManager::allocSlot(const std::string& key) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = (uint32_t)slots.size();
+        slots.emplace_back();
+    }
+    Slot& slot = slots[index];
+    slot.path = key;
+    slot.refs = 1;
+    slot.uploaded = true;
+    byPath[key] = index;
+    return index;
+}
+
+void AssetManager::enqueue(DecodeJob&& job) {
+    slots[job.slot].uploaded = false;
+    ++pendingDecodes;
+    startWorkers();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobCv.notify_one();
+}
+
+bool AssetManager::validHandle(TextureHandle handle) const {
+    return handle.valid() && handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+}
+
+TextureHandle AssetManager::acquire(const std::string& path) {
+    auto it = byPath.find(path);
+    if (it != byPath.end()) {
+        Slot& slot = slots[it->second];
+        slot.refs++;
+        return {it->second, slot.generation};
+    }
+
+    uint32_t index = allocSlot(path);
+    Slot& slot = slots[index];
+    int width = 0, height = 0;
+    if (readPngSize(path, width, height)) {
+        slot.texture = createTexture(width, height, BLANK);  // Invisible hasta el upload
+        if (textureLoaded(slot.texture) && !isHeadless()) enqueue({index, slot.generation, path, {}, width, height});
+    } else {
+        // No es PNG (o no existe): carga síncrona como antes
+        slot.texture = loadTexture(path.c_str());
+    }
+    return {index, slot.generation};
+}
+
+TextureHandle AssetManager::acquireAtlas(const std::string& name, const std::vector<std::string>& paths, int maxSize) {
+    auto it = byPath.find(name);
+    if (it != byPath.end()) {
+        Slot& slot = slots[it->second];
+        slot.refs++;
+        return {it->second, slot.generation};
+    }
+
+    // Layout con las dimensiones de los headers: las regiones se conocen antes de decodificar
+    std::vector<AtlasInput> inputs;
+    std::vector<std::string> found;
+    for (const std::string& path : paths) {
+        int width = 0, height = 0;
+        if (!readPngSize(path, width, height)) {
+            std::cerr << "Atlas " << name << ": skipping " << path << " (missing or not PNG)" << std::endl;
+            continue;
+        }
+        inputs.push_back({width, height});
+        found.push_back(path);
+    }
+
+    uint32_t index = allocSlot(name);
+    AtlasLayout layout;
+    if (!packAtlas(inputs, 1, maxSize, layout)) {
+        std::cerr << "Atlas " << name << ": does not fit in " << maxSize << "x" << maxSize << std::endl;
+        return {index, slots[index].generation};
+    }
+
+    Slot& slot = slots[index];
+    DecodeJob job{index, slot.generation, name, {}, layout.width, layout.height};
+    for (size_t i = 0; i < found.size(); ++i) {
+        slot.regions[found[i]] = layout.rects[i];
+        job.parts.push_back({found[i], layout.rects[i]});
+    }
+    slot.texture = createTexture(layout.width, layout.height, BLANK);
+    if (textureLoaded(slot.texture) && !isHeadless()) enqueue(std::move(job));
+    return {index, slot.generation};
+}
+
+Rectangle AssetManager::region(TextureHandle atlas, const std::string& path) const {
+    if (!validHandle(atlas)) return Rectangle{0, 0, 0, 0};
+    auto it = slots[atlas.index].regions.find(path);
+    return it != slots[atlas.index].regions.end() ? it->second : Rectangle{0, 0, 0, 0};
+}
+
+std::unordered_map<std::string, Rectangle> AssetManager::regions(TextureHandle atlas) const {
+    if (!validHandle(atlas)) return {};
+    return slots[atlas.index].regions;
+}
+
+// Worker: decodifica cada parte y la copia a su rect, extruyendo 1 px de borde sobre el padding
+Image AssetManager::composeAtlas(const DecodeJob& job) {
+    Image page = GenImageColor(job.width, job.height, BLANK);
+    for (const AtlasPart& part : job.parts) {
+        Image image = LoadImage(part.path.c_str());
+        if (!image.data) continue;
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        const Rectangle& r = part.rect;
+        const float w = (float)image.width, h = (float)image.height;
+        ImageDraw(&page, image, {0, 0, w, h}, r, WHITE);
+        ImageDraw(&page, image, {0, 0, 1, h}, {r.x - 1, r.y, 1, h}, WHITE);
+        ImageDraw(&page, image, {w - 1, 0, 1, h}, {r.x + w, r.y, 1, h}, WHITE);
+        ImageDraw(&page, image, {0, 0, w, 1}, {r.x, r.y - 1, w, 1}, WHITE);
+        ImageDraw(&page, image, {0, h - 1, w, 1}, {r.x, r.y + h, w, 1}, WHITE);
+        UnloadImage(image);
+    }
+    return page;
+}
+
+Texture2D AssetManager::get(TextureHandle handle) const {
+    if (!validHandle(handle)) return Texture2D{};
+    return slots[handle.index].texture;
+}
+
+bool AssetManager::ready(TextureHandle handle) const {
+    if (!validHandle(handle)) return false;
+    return slots[handle.index].uploaded;
+}
+
+void AssetManager::release(TextureHandle& handle) {
+    if (!validHandle(handle)) {
+        handle = TextureHandle{};
+        return;
+    }
+    Slot& slot = slots[handle.index];
+    if (--slot.refs <= 0) {
+        unloadTexture(slot.texture);
+        byPath.erase(slot.path);
+        // Un decode en vuelo para este slot se descarta al subir (generation distinta)
+        slot = Slot{std::string(), Texture2D{}, 0, slot.generation + 1, false, {}};
+        freeSlots.push_back(handle.index);
+    }
+    handle = TextureHandle{};
+}
+
+void AssetManager::upload(Decoded& item) {
+    --pendingDecodes;
+    Slot& slot = slots[item.slot];
+    if (slot.generation == item.generation && slot.refs > 0) {
+        if (item.image.data && item.image.width == slot.texture.width && item.image.height == slot.texture.height) {
+            updateTexture(slot.texture, item.image.data);
+        } else {
+            std::cerr << "Asset decode failed: " << slot.path << std::endl;
+        }
+        slot.uploaded = true;
+    }
+    UnloadImage(item.image);
+}
+
+void AssetManager::pumpUploads(int maxUploads) {
+    if (pendingDecodes == 0) return;
+    PROFILE_ZONE("AssetManager::pumpUploads");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        toUpload.insert(toUpload.end(), decoded.begin(), decoded.end());
+        decoded.clear();
+    }
+
+    size_t count = std::min(toUpload.size(), (size_t)std::max(maxUploads, 0));
+    for (size_t i = 0; i < count; ++i) upload(toUpload[i]);
+    toUpload.erase(toUpload.begin(), toUpload.begin() + count);
+}
+
+void AssetManager::waitAll() {
+    pumpUploads(INT_MAX);
+    while (pendingDecodes > 0) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCv.wait(lock, [this] { return !decoded.empty(); });
+        }
+        pumpUploads(INT_MAX);
+    }
+}
@@ -0,0 +1,117 @@
+// src/atlas.cpp
+#include "atlas.h"
+#include <algorithm>
+#include <numeric>
+
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+    skyline.push_back({0, 0, width});
+}
+
+// y mínima para apoyar un rect de w x h empezando en el segmento index
+bool SkylinePacker::fits(size_t index, int w, int h, int& outY) const {
+    int x = skyline[index].x;
+    if (x + w > width) return false;
+    int y = 0;
+    int remaining = w;
+    for (size_t i = index; remaining > 0; ++i) {
+        if (i >= skyline.size()) return false;
+        y = std::max(y, skyline[i].y);
+        if (y + h > height) return false;
+        remaining -= skyline[i].w;
+    }
+    outY = y;
+    return true;
+}
+
+bool SkylinePacker::insert(int w, int h, int& outX, int& outY) {
+    // Bottom-left: menor borde superior, desempate por x
+    size_t best = skyline.size();
+    int bestY = 0, bestTop = height + 1;
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int y;
+        if (fits(i, w, h, y) && y + h < bestTop) {
+            best = i;
+            bestY = y;
+            bestTop = y + h;
+        }
+    }
+    if (best == skyline.size()) return false;
+
+    outX = skyline[best].x;
+    outY = bestY;
+
+    // Nuevo segmento encima del rect; recorta los que quedan debajo
+    skyline.insert(skyline.begin() + best, {outX, bestY + h, w});
+    for (size_t i = best + 1; i < skyline.size();) {
+        Segment& seg = skyline[i];
+        int prevEnd = skyline[i - 1].x + skyline[i - 1].w;
+        if (seg.x >= prevEnd) break;
+        int shrink = prevEnd - seg.x;
+        seg.x += shrink;
+        seg.w -= shrink;
+        if (seg.w > 0) break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Une vecinos a la misma altura
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].w += skyline[i + 1].w;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+static int nextPow2(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+bool packAtlas(const std::vector<AtlasInput>& inputs, int padding, int maxSize, AtlasLayout& out) {
+    // Más altos primero: el skyline queda más parejo
+    std::vector<size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (inputs[a].height != inputs[b].height) return inputs[a].height > inputs[b].height;
+        return inputs[a].width > inputs[b].width;
+    });
+
+    long long area = 0;
+    int widest = 1, tallest = 1;
+    for (const AtlasInput& in : inputs) {
+        int w = in.width + 2 * padding, h = in.height + 2 * padding;
+        area += (long long)w * h;
+        widest = std::max(widest, w);
+        tallest = std::max(tallest, h);
+    }
+
+    int pageW = nextPow2(widest), pageH = nextPow2(tallest);
+    while ((long long)pageW * pageH < area) (pageW <= pageH ? pageW : pageH) <<= 1;
+
+    while (pageW <= maxSize && pageH <= maxSize) {
+        SkylinePacker packer(pageW, pageH);
+        std::vector<Rectangle> rects(inputs.size());
+        bool ok = true;
+        for (size_t idx : order) {
+            const AtlasInput& in = inputs[idx];
+            int x, y;
+            if (!packer.insert(in.width + 2 * padding, in.height + 2 * padding, x, y)) {
+                ok = false;
+                break;
+            }
+            rects[idx] = {(float)(x + padding), (float)(y + padding), (float)in.width, (float)in.height};
+        }
+        if (ok) {
+            out.width = pageW;
+            out.height = pageH;
+            out.rects = std::move(rects);
+            return true;
+        }
+        (pageW <= pageH ? pageW : pageH) <<= 1;  // Crece alternando ejes
+    }
+    return false;
+}
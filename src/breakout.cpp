@@ -0,0 +1,431 @@
+// src/breakout.cpp
+#include "breakout.h"
+#include "components.h"
+#include "profiler.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <bit>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void BlockGrid::resize(int c, int r) {
+    cols = std::max(c, 0);
+    rows = std::max(r, 0);
+    wordsPerRow = (cols + 63) / 64;
+    alive.assign((size_t)rows * wordsPerRow, 0);
+    hp.assign((size_t)cols * rows, 0);
+    aliveCount = 0;
+}
+
+void BlockGrid::set(int cx, int cy, uint8_t hitPoints) {
+    uint64_t& word = alive[cy * wordsPerRow + (cx >> 6)];
+    const uint64_t bit = 1ull << (cx & 63);
+    if ((word & bit) != 0) aliveCount--;
+    hp[cy * cols + cx] = hitPoints;
+    if (hitPoints > 0) {
+        word |= bit;
+        aliveCount++;
+    } else {
+        word &= ~bit;
+    }
+}
+
+bool BlockGrid::damage(int cx, int cy) {
+    uint8_t& cell = hp[cy * cols + cx];
+    if (cell == 0 || --cell > 0) return false;
+    alive[cy * wordsPerRow + (cx >> 6)] &= ~(1ull << (cx & 63));
+    aliveCount--;
+    return true;
+}
+
+void BallSet::add(float px, float py, float pvx, float pvy) {
+    x.push_back(px);
+    y.push_back(py);
+    vx.push_back(pvx);
+    vy.push_back(pvy);
+    prevX.push_back(px);
+    prevY.push_back(py);
+    swept.push_back(0);
+}
+
+void BallSet::removeAt(size_t i) {
+    for (auto* v : {&x, &y, &vx, &vy, &prevX, &prevY}) {
+        (*v)[i] = v->back();
+        v->pop_back();
+    }
+    swept[i] = swept.back();
+    swept.pop_back();
+}
+
+void spawnBalls(BallSet& balls, int count, float size, float speed, float y, int screenWidth) {
+    balls.size = size;
+    for (int i = 0; i < count; ++i) {
+        // Abanico de ±0.6 rad repartido a lo ancho de la pantalla
+        float t = count > 1 ? (float)i / (count - 1) : 0.5f;
+        float angle = (t - 0.5f) * 1.2f;
+        float px = (i + 0.5f) / count * screenWidth - size / 2;
+        balls.add(px, y - size / 2, speed * sinf(angle), -speed * cosf(angle));
+    }
+}
+
+bool loadBreakoutLevel(const std::string& path, BlockGrid& grid, BallSet& balls, int screenWidth) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Breakout: no se pudo abrir " << path << " (se usa el nivel por defecto)" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNum = 0;
+    int row = 0;
+    while (std::getline(file, line)) {
+        ++lineNum;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+
+        std::istringstream in(line);
+        std::string key;
+        in >> key;
+        if (key == "size") {
+            int c = 0, r = 0;
+            in >> c >> r;
+            if (!in || c <= 0 || r <= 0) {  // Sin filas/columnas no hay grid (y cellRange dividiría por 0)
+                std::cerr << path << ":" << lineNum << ": 'size' necesita cols y rows > 0 (se usa el nivel por defecto)" << std::endl;
+                return false;
+            }
+            grid.resize(c, r);
+            row = 0;
+            continue;
+        }
+        if (key == "cell") {
+            in >> grid.cellW >> grid.cellH;
+            if (!in || !(grid.cellW > 0.0f) || !(grid.cellH > 0.0f)) {  // cellRange/sweepCells dividen por el tamaño
+                std::cerr << path << ":" << lineNum << ": 'cell' necesita ancho y alto > 0 (se usa el nivel por defecto)" << std::endl;
+                return false;
+            }
+            continue;
+        }
+        if (key == "origin") { in >> grid.origin.x >> grid.origin.y; continue; }
+        if (key == "gap") { in >> grid.gap; continue; }
+        if (key == "balls") {
+            int count = 0;
+            float size = 15.0f, speed = 150.0f, y = 0.0f;
+            in >> count >> size >> speed >> y;
+            spawnBalls(balls, count, size, speed, y, screenWidth);
+            continue;
+        }
+
+        // Fila de bloques
+        if (grid.cols == 0 || row >= grid.rows) {
+            std::cerr << path << ":" << lineNum << ": fila fuera de 'size' (se ignora)" << std::endl;
+            continue;
+        }
+        const int n = std::min((int)line.size(), grid.cols);
+        for (int cx = 0; cx < n; ++cx) {
+            char ch = line[cx];
+            if (ch >= '1' && ch <= '9') grid.set(cx, row, (uint8_t)(ch - '0'));
+            else if (ch != '.') {
+                std::cerr << path << ":" << lineNum << ": char '" << ch << "' desconocido (se toma como vacío)" << std::endl;
+            }
+        }
+        ++row;
+    }
+    if (grid.cols > 0 && !(grid.cellW > 0.0f && grid.cellH > 0.0f)) {
+        std::cerr << path << ": falta 'cell' (se usa el nivel por defecto)" << std::endl;
+        return false;
+    }
+    if (row < grid.rows) {
+        std::cerr << path << ": " << grid.rows - row << " filas faltantes (quedan vacías)" << std::endl;
+    }
+    return true;
+}
+
+// Epsilon para que una ball pegada a un bloque no cuente la celda del bloque como ocupada
+static constexpr float kSkin = 1e-3f;
+
+// Como sweepAxis de collision.cpp, pero en coordenadas relativas al origin del grid y con las celdas fuera
+// del grid vacías (el rango se recorta a [0, cells)). hitC/hitK = primera celda viva encontrada
+template<typename SolidFn>
+static float sweepCells(float lo, float extent, float move, int cells, int cross0, int cross1, float cellSize,
+                        int& hitC, int& hitK, SolidFn&& solid) {
+    if (cross0 > cross1) return lo + move;
+    const float hiEdge = lo + std::max(extent - kSkin, 0.0f);
+    if (move > 0) {
+        int from = std::max((int)floorf(hiEdge / cellSize) + 1, 0);
+        int to = std::min((int)floorf((hiEdge + move) / cellSize), cells - 1);
+        for (int c = from; c <= to; ++c) {
+            for (int k = cross0; k <= cross1; ++k) {
+                if (solid(c, k)) {
+                    hitC = c;
+                    hitK = k;
+                    return c * cellSize - (hiEdge - lo) - kSkin;  // Flush contra la cara del bloque
+                }
+            }
+        }
+    } else if (move < 0) {
+        int from = std::min((int)floorf(lo / cellSize) - 1, cells - 1);
+        int to = std::max((int)floorf((lo + move) / cellSize), 0);
+        for (int c = from; c >= to; --c) {
+            for (int k = cross0; k <= cross1; ++k) {
+                if (solid(c, k)) {
+                    hitC = c;
+                    hitK = k;
+                    return (c + 1) * cellSize;
+                }
+            }
+        }
+    }
+    return lo + move;
+}
+
+// Celdas ocupadas por [lo, lo+extent) en un eje, recortadas al grid
+static void cellRange(float lo, float extent, float cellSize, int cells, int& c0, int& c1) {
+    c0 = std::max((int)floorf(lo / cellSize), 0);
+    c1 = std::min((int)floorf((lo + std::max(extent - kSkin, 0.0f)) / cellSize), cells - 1);
+}
+
+// Barrido separado por ejes (X y después Y) a través de las celdas; cada golpe resta hp y refleja ese eje
+static void sweepBall(BlockGrid& grid, float& x, float& y, float& vx, float& vy, float size, float dt, BreakoutStepStats& stats) {
+    auto hit = [&](int cx, int cy) {
+        stats.hits++;
+        if (grid.damage(cx, cy)) stats.broken++;
+    };
+    float lx = x - grid.origin.x;
+    float ly = y - grid.origin.y;
+    int c0, c1, hitC = -1, hitK = -1;
+
+    cellRange(ly, size, grid.cellH, grid.rows, c0, c1);
+    lx = sweepCells(lx, size, vx * dt, grid.cols, c0, c1, grid.cellW, hitC, hitK,
+                    [&](int cx, int cy) { return grid.isAlive(cx, cy); });
+    if (hitC >= 0) {
+        vx = -vx;
+        hit(hitC, hitK);
+    }
+
+    hitC = -1;
+    cellRange(lx, size, grid.cellW, grid.cols, c0, c1);
+    ly = sweepCells(ly, size, vy * dt, grid.rows, c0, c1, grid.cellH, hitC, hitK,
+                    [&](int cy, int cx) { return grid.isAlive(cx, cy); });
+    if (hitC >= 0) {
+        vy = -vy;
+        hit(hitK, hitC);
+    }
+
+    x = lx + grid.origin.x;
+    y = ly + grid.origin.y;
+}
+
+// Kernel escalar (fallback y cola de 4): integra las no barridas, paredes, paddle y marca las perdidas en swept
+static void stepKernelScalar(BallSet& b, size_t begin, size_t end, Rectangle paddle, float dt, float screenWidth, float screenHeight) {
+    const float size = b.size;
+    const float paddleCenter = paddle.x + paddle.width / 2;
+    for (size_t i = begin; i < end; ++i) {
+        float x = b.x[i], y = b.y[i], vx = b.vx[i], vy = b.vy[i];
+        if (!b.swept[i]) {
+            x += vx * dt;
+            y += vy * dt;
+        }
+        if (x <= 0) { x = 0; vx = fabsf(vx); }
+        else if (x + size >= screenWidth) { x = screenWidth - size; vx = -fabsf(vx); }
+        if (y <= 0) { y = 0; vy = fabsf(vy); }
+
+        // Bordes que se tocan cuentan; solo si baja, así no queda pegada
+        bool onPaddle = vy > 0 && !(x > paddle.x + paddle.width || x + size < paddle.x ||
+                                    y > paddle.y + paddle.height || y + size < paddle.y);
+        if (onPaddle) {
+            vy = vy * -1.05f;
+            vx = (x + size / 2 - paddleCenter) * 5.0f;
+        }
+        b.x[i] = x; b.y[i] = y; b.vx[i] = vx; b.vy[i] = vy;
+        b.swept[i] = (y + size >= screenHeight) ? ~0u : 0u;
+    }
+}
+
+#if defined(__SSE2__)
+static inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Mismo cálculo que stepKernelScalar, 4 balls por iteración (blends en vez de branches)
+static size_t stepKernelSSE(BallSet& b, Rectangle paddle, float dt, float screenWidth, float screenHeight) {
+    const size_t n = b.count() & ~(size_t)3;
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vsize = _mm_set1_ps(b.size);
+    const __m128 halfSize = _mm_set1_ps(b.size / 2);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    const __m128 maxX = _mm_set1_ps(screenWidth - b.size);
+    const __m128 vw = _mm_set1_ps(screenWidth);
+    const __m128 vh = _mm_set1_ps(screenHeight);
+    const __m128 px0 = _mm_set1_ps(paddle.x), px1 = _mm_set1_ps(paddle.x + paddle.width);
+    const __m128 py0 = _mm_set1_ps(paddle.y), py1 = _mm_set1_ps(paddle.y + paddle.height);
+    const __m128 paddleCenter = _mm_set1_ps(paddle.x + paddle.width / 2);
+    const __m128 bounce = _mm_set1_ps(-1.05f);
+    const __m128 english = _mm_set1_ps(5.0f);
+
+    for (size_t i = 0; i < n; i += 4) {
+        __m128 x = _mm_loadu_ps(&b.x[i]), y = _mm_loadu_ps(&b.y[i]);
+        __m128 vx = _mm_loadu_ps(&b.vx[i]), vy = _mm_loadu_ps(&b.vy[i]);
+        __m128 swept = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&b.swept[i]));
+
+        x = _mm_add_ps(x, _mm_andnot_ps(swept, _mm_mul_ps(vx, vdt)));
+        y = _mm_add_ps(y, _mm_andnot_ps(swept, _mm_mul_ps(vy, vdt)));
+
+        __m128 left = _mm_cmple_ps(x, zero);
+        __m128 right = _mm_andnot_ps(left, _mm_cmpge_ps(_mm_add_ps(x, vsize), vw));
+        __m128 absVx = _mm_and_ps(vx, absMask);
+        x = select(left, zero, select(right, maxX, x));
+        vx = select(left, absVx, select(right, _mm_or_ps(absVx, signMask), vx));
+
+        __m128 top = _mm_cmple_ps(y, zero);
+        y = select(top, zero, y);
+        vy = select(top, _mm_and_ps(vy, absMask), vy);
+
+        __m128 bx1 = _mm_add_ps(x, vsize), by1 = _mm_add_ps(y, vsize);
+        __m128 onPaddle = _mm_and_ps(_mm_cmpgt_ps(vy, zero),
+                                     _mm_and_ps(_mm_and_ps(_mm_cmple_ps(x, px1), _mm_cmpge_ps(bx1, px0)),
+                                                _mm_and_ps(_mm_cmple_ps(y, py1), _mm_cmpge_ps(by1, py0))));
+        vy = select(onPaddle, _mm_mul_ps(vy, bounce), vy);
+        vx = select(onPaddle, _mm_mul_ps(_mm_sub_ps(_mm_add_ps(x, halfSize), paddleCenter), english), vx);
+
+        _mm_storeu_ps(&b.x[i], x);
+        _mm_storeu_ps(&b.y[i], y);
+        _mm_storeu_ps(&b.vx[i], vx);
+        _mm_storeu_ps(&b.vy[i], vy);
+        _mm_storeu_si128((__m128i*)&b.swept[i], _mm_castps_si128(_mm_cmpge_ps(by1, vh)));
+    }
+    return n;
+}
+
+// Broadphase: ~0u para las balls cuyo barrido (caja actual + vel*dt) toca los bounds del grid
+static size_t markCandidatesSSE(BallSet& b, Rectangle bounds, float dt) {
+    const size_t n = b.count() & ~(size_t)3;
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vsize = _mm_set1_ps(b.size);
+    const __m128 gx0 = _mm_set1_ps(bounds.x), gx1 = _mm_set1_ps(bounds.x + bounds.width);
+    const __m128 gy0 = _mm_set1_ps(bounds.y), gy1 = _mm_set1_ps(bounds.y + bounds.height);
+    for (size_t i = 0; i < n; i += 4) {
+        __m128 x = _mm_loadu_ps(&b.x[i]), y = _mm_loadu_ps(&b.y[i]);
+        __m128 nx = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(&b.vx[i]), vdt));
+        __m128 ny = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(&b.vy[i]), vdt));
+        __m128 x0 = _mm_min_ps(x, nx), x1 = _mm_add_ps(_mm_max_ps(x, nx), vsize);
+        __m128 y0 = _mm_min_ps(y, ny), y1 = _mm_add_ps(_mm_max_ps(y, ny), vsize);
+        __m128 touch = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(x0, gx1), _mm_cmpge_ps(x1, gx0)),
+                                  _mm_and_ps(_mm_cmple_ps(y0, gy1), _mm_cmpge_ps(y1, gy0)));
+        _mm_storeu_si128((__m128i*)&b.swept[i], _mm_castps_si128(touch));
+    }
+    return n;
+}
+#endif
+
+static void markCandidatesScalar(BallSet& b, size_t begin, size_t end, Rectangle bounds, float dt) {
+    for (size_t i = begin; i < end; ++i) {
+        float nx = b.x[i] + b.vx[i] * dt, ny = b.y[i] + b.vy[i] * dt;
+        bool touch = std::min(b.x[i], nx) <= bounds.x + bounds.width && std::max(b.x[i], nx) + b.size >= bounds.x &&
+                     std::min(b.y[i], ny) <= bounds.y + bounds.height && std::max(b.y[i], ny) + b.size >= bounds.y;
+        b.swept[i] = touch ? ~0u : 0u;
+    }
+}
+
+BreakoutStepStats stepBalls(BallSet& balls, BlockGrid& grid, Rectangle paddle, float dt, float screenWidth, float screenHeight) {
+    PROFILE_ZONE("stepBalls");
+    BreakoutStepStats stats;
+    const size_t n = balls.count();
+    std::copy(balls.x.begin(), balls.x.end(), balls.prevX.begin());
+    std::copy(balls.y.begin(), balls.y.end(), balls.prevY.begin());
+
+    // 1) Broadphase vectorizada + sweep escalar por celdas solo para las que tocan el grid
+    if (grid.aliveCount > 0) {
+        size_t done = 0;
+#if defined(__SSE2__)
+        done = markCandidatesSSE(balls, grid.bounds(), dt);
+#endif
+        markCandidatesScalar(balls, done, n, grid.bounds(), dt);
+        for (size_t i = 0; i < n; ++i) {
+            if (!balls.swept[i]) continue;
+            stats.candidates++;
+            sweepBall(grid, balls.x[i], balls.y[i], balls.vx[i], balls.vy[i], balls.size, dt, stats);
+        }
+    } else {
+        std::fill(balls.swept.begin(), balls.swept.end(), 0u);
+    }
+
+    // 2) Integración (las no barridas) + paredes + paddle; swept pasa a marcar las perdidas
+    size_t done = 0;
+#if defined(__SSE2__)
+    done = stepKernelSSE(balls, paddle, dt, screenWidth, screenHeight);
+#endif
+    stepKernelScalar(balls, done, n, paddle, dt, screenWidth, screenHeight);
+
+    // 3) Remueve las que cayeron (de atrás para adelante: el swap trae una ya revisada)
+    for (size_t i = n; i-- > 0;) {
+        if (!balls.swept[i]) continue;
+        balls.removeAt(i);
+        stats.lost++;
+    }
+    return stats;
+}
+
+void systemBreakoutBalls(ECS& ecs, float dt, int screenWidth, int screenHeight, BreakoutStepStats& stats) {
+    PROFILE_ZONE("systemBreakoutBalls");
+    Rectangle paddle = {0, -1e9f, 0, 0};  // Sin paddle: nunca toca
+    for (auto& [entity, _] : ecs.getComponentMap<PaddleControlled>()) {
+        auto* pos = ecs.getComponent<Position>(entity);
+        auto* size = ecs.getComponent<Size>(entity);
+        if (!pos || !size) continue;
+        paddle = {pos->pos.x, pos->pos.y, size->w, size->h};
+        break;
+    }
+
+    stats = {};
+    for (auto& [entity, balls] : ecs.getComponentMap<BallSet>()) {
+        auto* grid = ecs.getComponent<BlockGrid>(entity);
+        if (!grid) continue;
+        BreakoutStepStats s = stepBalls(balls, *grid, paddle, dt, (float)screenWidth, (float)screenHeight);
+        stats.candidates += s.candidates;
+        stats.hits += s.hits;
+        stats.broken += s.broken;
+        stats.lost += s.lost;
+    }
+}
+
+void systemRenderBreakout(ECS& ecs, RenderQueue& queue, float alpha) {
+    PROFILE_ZONE("systemRenderBreakout");
+    CommandBuffer& out = queue.main();
+    static const Color hpColors[] = {RED, ORANGE, GOLD, LIME, SKYBLUE, BLUE, PURPLE, VIOLET, DARKGRAY};
+
+    for (auto& [entity, grid] : ecs.getComponentMap<BlockGrid>()) {
+        const float inset = grid.gap / 2;
+        for (int cy = 0; cy < grid.rows; ++cy) {
+            // Recorre solo los bits vivos de cada word
+            for (int w = 0; w < grid.wordsPerRow; ++w) {
+                uint64_t bits = grid.alive[cy * grid.wordsPerRow + w];
+                while (bits) {
+                    int cx = w * 64 + std::countr_zero(bits);
+                    bits &= bits - 1;
+                    Rectangle r = grid.cellRect(cx, cy);
+                    out.rect(RenderLayer::Tiles, {(float)(int)(r.x + inset), (float)(int)(r.y + inset),
+                                                  (float)(int)(r.width - grid.gap), (float)(int)(r.height - grid.gap)},
+                             hpColors[grid.hp[cy * grid.cols + cx] - 1]);
+                }
+            }
+        }
+    }
+
+    for (auto& [entity, balls] : ecs.getComponentMap<BallSet>()) {
+        const int size = (int)balls.size;
+        for (size_t i = 0; i < balls.count(); ++i) {
+            float x = balls.prevX[i] + (balls.x[i] - balls.prevX[i]) * alpha;
+            float y = balls.prevY[i] + (balls.y[i] - balls.prevY[i]) * alpha;
+            out.rect(RenderLayer::Sprites, {(float)(int)x, (float)(int)y, (float)size, (float)size}, BLACK);
+        }
+    }
+}
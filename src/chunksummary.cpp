@@ -0,0 +1,260 @@
+// src/chunksummary.cpp
+#include "chunksummary.h"
+#include "systems.h"
+#include "platform.h"
+#include "profiler.h"
+#include <cmath>
+#include <algorithm>
+
+// Sin pixels del tile: color representativo del tipo (el minimapa sigue siendo legible)
+static Color flatColor(IntGridValue value) {
+    switch (value) {
+        case IntGridValue::NON_WALKABLE: return {96, 96, 104, 255};
+        case IntGridValue::HAZARD: return {200, 90, 40, 255};
+        case IntGridValue::PICKUP: return {230, 200, 60, 255};
+        default: return {70, 120, 70, 255};
+    }
+}
+
+// Box filter 4x4 (como un mip de 2 niveles); los bordes que no llegan a 4 promedian lo que hay
+static void downsample4(const Color* src, int srcSide, Color* dst, int dstSide) {
+    for (int dy = 0; dy < dstSide; ++dy) {
+        for (int dx = 0; dx < dstSide; ++dx) {
+            unsigned int r = 0, g = 0, b = 0, a = 0, n = 0;
+            for (int y = dy * 4; y < std::min(dy * 4 + 4, srcSide); ++y) {
+                for (int x = dx * 4; x < std::min(dx * 4 + 4, srcSide); ++x) {
+                    const Color& c = src[y * srcSide + x];
+                    r += c.r; g += c.g; b += c.b; a += c.a;
+                    ++n;
+                }
+            }
+            dst[dy * dstSide + dx] = n ? Color{(unsigned char)(r / n), (unsigned char)(g / n), (unsigned char)(b / n), (unsigned char)(a / n)}
+                                       : Color{0, 0, 0, 0};
+        }
+    }
+}
+
+ChunkSummaries::~ChunkSummaries() {
+    clear();
+}
+
+void ChunkSummaries::releaseSources() {
+    for (auto& [id, image] : sources) UnloadImage(image);
+    sources.clear();
+    sampleIndex.clear();
+    samples.clear();
+}
+
+void ChunkSummaries::clear() {
+    for (Chunk& chunk : chunks) {
+        for (Texture2D& texture : chunk.levels) unloadTexture(texture);
+    }
+    chunks.clear();
+    unloadTexture(page);
+    page = {};
+    releaseSources();
+    built = false;
+}
+
+const Color* ChunkSummaries::tileSample(const TileMap& tilemap, const Tile& tile) {
+    if (!sourcesReady) return nullptr;
+    Texture2D texture;
+    const Rectangle src = tileSource(tilemap, tile, texture);
+    if (texture.id == 0 || src.width <= 0 || src.height <= 0) return nullptr;
+
+    const uint64_t key = ((uint64_t)texture.id << 40) ^ ((uint64_t)(uint32_t)src.x << 20) ^ (uint64_t)(uint32_t)src.y;
+    auto found = sampleIndex.find(key);
+    if (found != sampleIndex.end()) return found->second == kNoSample ? nullptr : &samples[found->second];
+
+    auto source = sources.find(texture.id);
+    if (source == sources.end()) source = sources.emplace(texture.id, readTexture(texture)).first;
+    const Image& image = source->second;
+    if (!image.data) {
+        sampleIndex.emplace(key, kNoSample);
+        return nullptr;
+    }
+
+    // Sub-rect -> sampleSize x sampleSize promediando los texels que cubre cada celda
+    const uint32_t offset = (uint32_t)samples.size();
+    samples.resize(offset + sampleSize * sampleSize);
+    const Color* pixels = static_cast<const Color*>(image.data);
+    for (int sy = 0; sy < sampleSize; ++sy) {
+        const int y0 = std::clamp((int)(src.y + src.height * sy / sampleSize), 0, image.height - 1);
+        const int y1 = std::clamp((int)(src.y + src.height * (sy + 1) / sampleSize), y0 + 1, image.height);
+        for (int sx = 0; sx < sampleSize; ++sx) {
+            const int x0 = std::clamp((int)(src.x + src.width * sx / sampleSize), 0, image.width - 1);
+            const int x1 = std::clamp((int)(src.x + src.width * (sx + 1) / sampleSize), x0 + 1, image.width);
+            unsigned int r = 0, g = 0, b = 0, a = 0, n = 0;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    const Color& c = pixels[y * image.width + x];
+                    r += c.r; g += c.g; b += c.b; a += c.a;
+                    ++n;
+                }
+            }
+            samples[offset + sy * sampleSize + sx] = {(unsigned char)(r / n), (unsigned char)(g / n), (unsigned char)(b / n), (unsigned char)(a / n)};
+        }
+    }
+    sampleIndex.emplace(key, offset);
+    return &samples[offset];
+}
+
+uint64_t ChunkSummaries::computeSignature(const TileMap& tilemap, int cx, int cy) const {
+    const int x0 = cx * chunkSize, y0 = cy * chunkSize;
+    const int x1 = std::min(x0 + chunkSize, width), y1 = std::min(y0 + chunkSize, height);
+    uint64_t h = 1469598103934665603ull;  // FNV-1a de lo que decide el sample: tipo, frame y special
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const Tile& tile = tilemap.tiles[y * width + x];
+            h = (h ^ (uint64_t)tile.value) * 1099511628211ull;
+            h = (h ^ ((uint64_t)(uint32_t)tile.frame.x << 16 | (uint32_t)tile.frame.y)) * 1099511628211ull;
+            h = (h ^ tile.specialTex.id) * 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+void ChunkSummaries::rebuild(const TileMap& tilemap, int cx, int cy, Chunk& chunk) {
+    // Nivel 1 desde los samples; 2 y 3 por box filter del anterior
+    const int x0 = cx * chunkSize, y0 = cy * chunkSize;
+    std::vector<Color>& base = scratch[0];
+    base.assign(side[0] * side[0], Color{0, 0, 0, 0});  // Fuera del mapa (chunk de borde): transparente
+    for (int y = 0; y < chunkSize && y0 + y < height; ++y) {
+        for (int x = 0; x < chunkSize && x0 + x < width; ++x) {
+            const Tile& tile = tilemap.tiles[(y0 + y) * width + x0 + x];
+            const Color* sample = tileSample(tilemap, tile);
+            const Color flat = flatColor(tile.value);
+            for (int sy = 0; sy < sampleSize; ++sy) {
+                Color* row = &base[(y * sampleSize + sy) * side[0] + x * sampleSize];
+                for (int sx = 0; sx < sampleSize; ++sx) row[sx] = sample ? sample[sy * sampleSize + sx] : flat;
+            }
+        }
+    }
+    for (int level = 1; level < kLevels; ++level) {
+        scratch[level].resize(side[level] * side[level]);
+        downsample4(scratch[level - 1].data(), side[level - 1], scratch[level].data(), side[level]);
+    }
+
+    for (int level = 0; level < kLevels - 1; ++level) {
+        if (!textureLoaded(chunk.levels[level])) chunk.levels[level] = createTexture(side[level], side[level], BLANK);
+        updateTexture(chunk.levels[level], scratch[level].data());
+    }
+    const float coarse = (float)side[kLevels - 1];
+    updateTextureRect(page, {cx * coarse, cy * coarse, coarse, coarse}, scratch[kLevels - 1].data());
+    ++lastRebuilds;
+}
+
+void ChunkSummaries::sync(const TileMap& tilemap, bool texturesReady) {
+    lastRebuilds = 0;
+    if (tilemap.tiles.size() != (size_t)(tilemap.width * tilemap.height) || tilemap.chunkSize <= 0 || tilemap.tileSize <= 0) return;
+    const bool sourcesChanged = texturesReady != sourcesReady;
+    if (sourcesChanged) {
+        releaseSources();
+        sourcesReady = texturesReady;
+    }
+    const bool resized = !built || tilemap.width != width || tilemap.height != height ||
+                         tilemap.chunkSize != chunkSize || tilemap.tileSize != tileSize;
+    if (!resized && !sourcesChanged && tilemap.revision == revision) return;
+    PROFILE_ZONE("ChunkSummaries::sync");
+
+    if (resized) {
+        // Como IntGridOverlay: las texturas por chunk se reusan si no cambió su tamaño; la página se rehace
+        std::vector<Chunk> old = std::move(chunks);
+        width = tilemap.width;
+        height = tilemap.height;
+        if (tilemap.chunkSize != chunkSize || tilemap.tileSize != tileSize) {
+            for (Chunk& chunk : old) {
+                for (Texture2D& texture : chunk.levels) unloadTexture(texture);
+            }
+            old.clear();
+            chunkSize = tilemap.chunkSize;
+            tileSize = tilemap.tileSize;
+            sampleSize = std::max(1, tileSize / 4);
+            side[0] = chunkSize * sampleSize;
+            for (int level = 1; level < kLevels; ++level) side[level] = std::max(1, (side[level - 1] + 3) / 4);
+            sampleIndex.clear();
+            samples.clear();
+        }
+        chunksX = (width + chunkSize - 1) / chunkSize;
+        chunksY = (height + chunkSize - 1) / chunkSize;
+        chunks.assign(chunksX * chunksY, Chunk{});
+        for (size_t i = 0; i < chunks.size() && i < old.size(); ++i) {
+            for (int level = 0; level < kLevels - 1; ++level) chunks[i].levels[level] = old[i].levels[level];
+        }
+        for (size_t i = chunks.size(); i < old.size(); ++i) {
+            for (Texture2D& texture : old[i].levels) unloadTexture(texture);
+        }
+        unloadTexture(page);
+        page = createTexture(chunksX * side[kLevels - 1], chunksY * side[kLevels - 1], BLANK);
+    }
+    revision = tilemap.revision;
+    built = true;
+
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            Chunk& chunk = chunks[cy * chunksX + cx];
+            uint64_t sig = computeSignature(tilemap, cx, cy);
+            if (!resized && !sourcesChanged && sig == chunk.signature) continue;
+            chunk.signature = sig;
+            rebuild(tilemap, cx, cy, chunk);
+        }
+    }
+}
+
+int ChunkSummaries::levelForZoom(const TileMap& tilemap, float zoom) const {
+    if (!built) return 0;
+    // Pixels de pantalla por texel del tileset = scale * zoom; cada nivel divide por 4 los texels por lado
+    const float magnification = tilemap.scale * zoom;
+    if (magnification <= 0.0f) return kLevels;
+    const int level = (int)floorf(log2f(1.0f / magnification) / 2.0f + 0.5f + lodBias);
+    return std::clamp(level, 0, kLevels);
+}
+
+void ChunkSummaries::submit(const TileMap& tilemap, CommandBuffer& out, Rectangle view, int level) {
+    PROFILE_ZONE("ChunkSummaries::submit");
+    lastDrawn = 0;
+    if (!built || level < 1 || level > kLevels) return;
+
+    const float chunkWorld = chunkSize * tilemap.tileSize * tilemap.scale;
+    const int startX = std::max(0, (int)floorf(view.x / chunkWorld));
+    const int startY = std::max(0, (int)floorf(view.y / chunkWorld));
+    const int endX = std::min(chunksX - 1, (int)floorf((view.x + view.width) / chunkWorld));
+    const int endY = std::min(chunksY - 1, (int)floorf((view.y + view.height) / chunkWorld));
+    const float s = (float)side[level - 1];
+    for (int cy = startY; cy <= endY; ++cy) {
+        for (int cx = startX; cx <= endX; ++cx) {
+            const Rectangle dst = {cx * chunkWorld, cy * chunkWorld, chunkWorld, chunkWorld};
+            if (level == kLevels) {
+                out.quad(RenderLayer::Tiles, page, {cx * s, cy * s, s, s}, dst, WHITE);  // Todos con la misma textura
+            } else {
+                out.quad(RenderLayer::Tiles, chunks[cy * chunksX + cx].levels[level - 1], {0, 0, s, s}, dst, WHITE);
+            }
+            ++lastDrawn;
+        }
+    }
+}
+
+void ChunkSummaries::submitMinimap(const TileMap& tilemap, CommandBuffer& out, Rectangle screenRect, Rectangle view, Vector2 player) {
+    if (!built || page.width <= 0 || page.height <= 0) return;
+
+    // Ajuste sin deformar, arriba a la izquierda de screenRect
+    const float fit = std::min(screenRect.width / page.width, screenRect.height / page.height);
+    const Rectangle dst = {screenRect.x, screenRect.y, page.width * fit, page.height * fit};
+    // Depth: marco 0 < página 1 < vista y player 2 (el resto del HUD va en 0)
+    out.rect(RenderLayer::Hud, {dst.x - 2, dst.y - 2, dst.width + 4, dst.height + 4}, Color{0, 0, 0, 160});
+    out.quad(RenderLayer::Hud, page, {0, 0, (float)page.width, (float)page.height}, dst, WHITE, 1);
+
+    // World -> minimapa: cada texel de la página cubre chunkWorld / side[2] unidades
+    const float chunkWorld = chunkSize * tilemap.tileSize * tilemap.scale;
+    const float toMap = fit * side[kLevels - 1] / chunkWorld;
+    auto project = [&](float x, float y) {
+        return Vector2{dst.x + std::clamp(x * toMap, 0.0f, dst.width), dst.y + std::clamp(y * toMap, 0.0f, dst.height)};
+    };
+    const Vector2 a = project(view.x, view.y), b = project(view.x + view.width, view.y);
+    const Vector2 c = project(view.x + view.width, view.y + view.height), d = project(view.x, view.y + view.height);
+    const Vector2 outline[8] = {a, b, b, c, c, d, d, a};
+    std::copy(outline, outline + 8, minimapLines);
+    out.lines(RenderLayer::Hud, minimapLines, 8, 1.0f, WHITE, 2);
+    const Vector2 p = project(player.x, player.y);
+    out.rect(RenderLayer::Hud, {p.x - 2, p.y - 2, 4, 4}, RED, 2);
+}
@@ -0,0 +1,112 @@
+// src/collision.cpp
+#include "collision.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+SweepHit sweepAABB(Rectangle a, Vector2 d, Rectangle b) {
+    SweepHit result;
+
+    // Solape inicial: separa por el eje de menor penetración
+    float overlapX = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+    float overlapY = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+    if (overlapX > 0 && overlapY > 0) {
+        result.hit = true;
+        result.t = 0.0f;
+        if (overlapX < overlapY) result.normal = {(a.x + a.width / 2 < b.x + b.width / 2) ? -1.0f : 1.0f, 0};
+        else result.normal = {0, (a.y + a.height / 2 < b.y + b.height / 2) ? -1.0f : 1.0f};
+        return result;
+    }
+
+    // Distancias de entrada/salida por eje (slab test sobre la suma de Minkowski)
+    const float inf = std::numeric_limits<float>::infinity();
+    float entryX, exitX, entryY, exitY;
+    if (d.x > 0)      { entryX = (b.x - (a.x + a.width)) / d.x;  exitX = (b.x + b.width - a.x) / d.x; }
+    else if (d.x < 0) { entryX = (b.x + b.width - a.x) / d.x;    exitX = (b.x - (a.x + a.width)) / d.x; }
+    else {
+        if (a.x + a.width <= b.x || a.x >= b.x + b.width) return result;  // Nunca cruza en X
+        entryX = -inf; exitX = inf;
+    }
+    if (d.y > 0)      { entryY = (b.y - (a.y + a.height)) / d.y; exitY = (b.y + b.height - a.y) / d.y; }
+    else if (d.y < 0) { entryY = (b.y + b.height - a.y) / d.y;   exitY = (b.y - (a.y + a.height)) / d.y; }
+    else {
+        if (a.y + a.height <= b.y || a.y >= b.y + b.height) return result;
+        entryY = -inf; exitY = inf;
+    }
+
+    float entry = std::max(entryX, entryY);
+    float exit = std::min(exitX, exitY);
+    if (entry > exit || entry < 0.0f || entry > 1.0f) return result;
+
+    result.hit = true;
+    result.t = entry;
+    if (entryX > entryY) result.normal = {d.x > 0 ? -1.0f : 1.0f, 0};
+    else result.normal = {0, d.y > 0 ? -1.0f : 1.0f};
+    return result;
+}
+
+bool isSolidTile(const TileMap& tilemap, int tx, int ty) {
+    if (tx < 0 || tx >= tilemap.width || ty < 0 || ty >= tilemap.height) return true;
+    return tilemap.tiles[ty * tilemap.width + tx].value == IntGridValue::NON_WALKABLE;
+}
+
+// Epsilon para que un box pegado al muro no cuente la celda del muro como ocupada
+static constexpr float kSkin = 1e-3f;
+
+// Mueve lo..lo+extent una distancia move en un eje; cross0..cross1 = celdas ocupadas en el otro eje.
+// Devuelve el nuevo lo y marca hit si un tile sólido lo detuvo
+template<typename SolidFn>
+static float sweepAxis(float lo, float extent, float move, int cross0, int cross1, float tileWorld, bool& hit, SolidFn&& solid) {
+    const float hiEdge = lo + std::max(extent - kSkin, 0.0f);
+    if (move > 0) {
+        int from = (int)floorf(hiEdge / tileWorld) + 1;
+        int to = (int)floorf((hiEdge + move) / tileWorld);
+        for (int c = from; c <= to; ++c) {
+            for (int k = cross0; k <= cross1; ++k) {
+                if (solid(c, k)) {
+                    hit = true;
+                    return c * tileWorld - (hiEdge - lo) - kSkin;  // Flush contra la cara del tile
+                }
+            }
+        }
+    } else if (move < 0) {
+        int from = (int)floorf(lo / tileWorld) - 1;
+        int to = (int)floorf((lo + move) / tileWorld);
+        for (int c = from; c >= to; --c) {
+            for (int k = cross0; k <= cross1; ++k) {
+                if (solid(c, k)) {
+                    hit = true;
+                    return (c + 1) * tileWorld;
+                }
+            }
+        }
+    }
+    return lo + move;
+}
+
+TileSweep sweepTiles(const TileMap& tilemap, Rectangle box, Vector2 delta) {
+    TileSweep out;
+    const float tileWorld = tilemap.tileSize * tilemap.scale;
+
+    // Eje X: filas ocupadas por el box actual
+    int row0 = (int)floorf(box.y / tileWorld);
+    int row1 = (int)floorf((box.y + std::max(box.height - kSkin, 0.0f)) / tileWorld);
+    float newX = sweepAxis(box.x, box.width, delta.x, row0, row1, tileWorld, out.hitX,
+                           [&](int c, int k) { return isSolidTile(tilemap, c, k); });
+
+    // Eje Y con la X ya resuelta (esto es lo que permite deslizar)
+    int col0 = (int)floorf(newX / tileWorld);
+    int col1 = (int)floorf((newX + std::max(box.width - kSkin, 0.0f)) / tileWorld);
+    float newY = sweepAxis(box.y, box.height, delta.y, col0, col1, tileWorld, out.hitY,
+                           [&](int c, int k) { return isSolidTile(tilemap, k, c); });
+
+    out.pos = {newX, newY};
+    return out;
+}
+
+void sweepMany(const TileMap& tilemap, const std::vector<SweepBody>& bodies, std::vector<TileSweep>& out) {
+    out.resize(bodies.size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        out[i] = sweepTiles(tilemap, bodies[i].box, bodies[i].delta);
+    }
+}
@@ -0,0 +1,117 @@
+// src/culling.cpp
+#include "culling.h"
+#include "profiler.h"
+#include <cmath>
+#include <algorithm>
+
+Rectangle spriteBounds(const Sprite& sprite, Vector2 pos) {
+    const Size size = spriteSize(sprite);
+    return {pos.x - sprite.origin.x * sprite.scale.x, pos.y - sprite.origin.y * sprite.scale.y, size.w, size.h};
+}
+
+Rectangle cameraViewRect(const Camera2D& cam) {
+    const float zoom = cam.zoom > 0.0f ? cam.zoom : 1.0f;
+    return {cam.target.x - cam.offset.x / zoom, cam.target.y - cam.offset.y / zoom,
+            GetScreenWidth() / zoom, GetScreenHeight() / zoom};
+}
+
+SpriteCuller::SpriteCuller(float cellSize, float margin) : cellSize(cellSize), margin(margin) {}
+
+static uint64_t cellKey(int cx, int cy) {
+    return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+}
+
+SpriteCuller::CellRange SpriteCuller::cellsOf(const Sprite& sprite, const Position& pos) const {
+    // Unión de prev y pos: cubre cualquier posición interpolada del tick
+    Rectangle a = spriteBounds(sprite, pos.pos);
+    Rectangle b = pos.hasPrev ? spriteBounds(sprite, pos.prev) : a;
+    float x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+    float x1 = std::max(a.x + a.width, b.x + b.width), y1 = std::max(a.y + a.height, b.y + b.height);
+    return {(int)floorf(x0 / cellSize), (int)floorf(y0 / cellSize), (int)floorf(x1 / cellSize), (int)floorf(y1 / cellSize)};
+}
+
+void SpriteCuller::place(Entity entity, const CellRange& cells) {
+    for (int cy = cells.y0; cy <= cells.y1; ++cy) {
+        for (int cx = cells.x0; cx <= cells.x1; ++cx) buckets[cellKey(cx, cy)].push_back(entity);
+    }
+}
+
+void SpriteCuller::unplace(Entity entity, const CellRange& cells) {
+    for (int cy = cells.y0; cy <= cells.y1; ++cy) {
+        for (int cx = cells.x0; cx <= cells.x1; ++cx) {
+            std::vector<Entity>& bucket = buckets[cellKey(cx, cy)];
+            auto it = std::find(bucket.begin(), bucket.end(), entity);
+            if (it == bucket.end()) continue;
+            *it = bucket.back();  // Swap-remove: el orden se rehace con el sort del query
+            bucket.pop_back();
+        }
+    }
+}
+
+void SpriteCuller::rebuild(ECS& ecs) {
+    PROFILE_ZONE("SpriteCuller::rebuild");
+    for (auto& [key, bucket] : buckets) bucket.clear();
+    movers.clear();
+    auto& velocities = ecs.getComponentMap<Velocity>();
+    for (auto& [entity, sprite] : ecs.getComponentMap<Sprite>()) {
+        auto* pos = ecs.getComponent<Position>(entity);
+        if (!pos) continue;
+        const CellRange cells = cellsOf(sprite, *pos);
+        place(entity, cells);
+        if (velocities.count(entity)) movers.push_back({entity, pos, &sprite, cells});
+    }
+    dirty = false;
+    moved = false;
+    const EntityIndex& index = ecs.getEntityIndex();
+    indexOwner = &index;
+    indexVersion = index.version;
+    stats.rebuilds++;
+    stats.movers = (int)movers.size();
+}
+
+bool SpriteCuller::updateMovers() {
+    PROFILE_ZONE("SpriteCuller::updateMovers");
+    int relocated = 0;
+    for (Mover& mover : movers) {
+        const CellRange cells = cellsOf(*mover.sprite, *mover.pos);
+        if (cells == mover.cells) continue;  // Se movió dentro de sus celdas: el grid no cambia
+        unplace(mover.entity, mover.cells);
+        place(mover.entity, cells);
+        mover.cells = cells;
+        ++relocated;
+    }
+    moved = false;
+    stats.relocated = relocated;
+    return relocated > 0;
+}
+
+const std::vector<Entity>& SpriteCuller::query(ECS& ecs, Rectangle view) {
+    const EntityIndex& index = ecs.getEntityIndex();
+    bool changed = false;
+    if (dirty || indexOwner != &index || indexVersion != index.version) {
+        rebuild(ecs);
+        changed = true;
+    } else if (moved) {
+        changed = updateMovers();
+    }
+
+    // Vista + margen redondeada a celdas: mientras la cámara no cruce una celda, el set no cambia
+    const int cells[4] = {(int)floorf((view.x - margin) / cellSize), (int)floorf((view.y - margin) / cellSize),
+                          (int)floorf((view.x + view.width + margin) / cellSize),
+                          (int)floorf((view.y + view.height + margin) / cellSize)};
+    stats.cached = !changed && std::equal(cells, cells + 4, cachedCells);
+    if (stats.cached) return visible;
+
+    std::copy(cells, cells + 4, cachedCells);
+    visible.clear();
+    for (int cy = cells[1]; cy <= cells[3]; ++cy) {
+        for (int cx = cells[0]; cx <= cells[2]; ++cx) {
+            auto it = buckets.find(cellKey(cx, cy));
+            if (it != buckets.end()) visible.insert(visible.end(), it->second.begin(), it->second.end());
+        }
+    }
+    // Multi-celda: dedup; orden por entity (orden de dibujo estable)
+    std::sort(visible.begin(), visible.end());
+    visible.erase(std::unique(visible.begin(), visible.end()), visible.end());
+    return visible;
+}
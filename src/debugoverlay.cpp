@@ -0,0 +1,216 @@
+// src/debugoverlay.cpp
+#include "debugoverlay.h"
+#include "platform.h"
+#include "profiler.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+static Color intGridColor(IntGridValue value) {
+    switch (value) {
+        case IntGridValue::NON_WALKABLE: return {255, 0, 0, 128};
+        case IntGridValue::HAZARD: return {255, 165, 0, 128};
+        case IntGridValue::PICKUP: return {0, 255, 0, 128};
+        default: return {0, 0, 0, 0};
+    }
+}
+
+IntGridOverlay::~IntGridOverlay() {
+    clear();
+}
+
+void IntGridOverlay::clear() {
+    for (Chunk& chunk : chunks) unloadTexture(chunk.texture);
+    chunks.clear();
+    built = false;
+}
+
+uint64_t IntGridOverlay::computeSignature(const TileMap& tilemap, int cx, int cy) const {
+    const int x0 = cx * chunkSize, y0 = cy * chunkSize;
+    const int x1 = std::min(x0 + chunkSize, width), y1 = std::min(y0 + chunkSize, height);
+    uint64_t h = 1469598103934665603ull;  // FNV-1a
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            h = (h ^ (uint64_t)tilemap.tiles[y * width + x].value) * 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+void IntGridOverlay::upload(const TileMap& tilemap, int cx, int cy, Chunk& chunk) {
+    const int x0 = cx * chunkSize, y0 = cy * chunkSize;
+    pixels.assign(chunkSize * chunkSize, Color{0, 0, 0, 0});  // Fuera del mapa (chunk de borde): transparente
+    chunk.empty = true;
+    for (int y = 0; y < chunkSize && y0 + y < height; ++y) {
+        for (int x = 0; x < chunkSize && x0 + x < width; ++x) {
+            Color color = intGridColor(tilemap.tiles[(y0 + y) * width + x0 + x].value);
+            pixels[y * chunkSize + x] = color;
+            if (color.a != 0) chunk.empty = false;
+        }
+    }
+    if (!textureLoaded(chunk.texture)) chunk.texture = createTexture(chunkSize, chunkSize, BLANK);
+    updateTexture(chunk.texture, pixels.data());
+    ++lastUploads;
+}
+
+void IntGridOverlay::sync(const TileMap& tilemap) {
+    lastUploads = 0;
+    if (tilemap.tiles.size() != (size_t)(tilemap.width * tilemap.height) || tilemap.chunkSize <= 0) return;
+    const bool resized = !built || tilemap.width != width || tilemap.height != height || tilemap.chunkSize != chunkSize;
+    if (!resized && tilemap.revision == revision) return;
+    PROFILE_ZONE("IntGridOverlay::sync");
+
+    if (resized) {
+        // Expansión (o shift left/top): cambian los índices de chunk; las texturas se reusan, las firmas no
+        std::vector<Chunk> old = std::move(chunks);
+        width = tilemap.width;
+        height = tilemap.height;
+        if (tilemap.chunkSize != chunkSize) {
+            for (Chunk& chunk : old) unloadTexture(chunk.texture);
+            old.clear();
+            chunkSize = tilemap.chunkSize;
+        }
+        chunksX = (width + chunkSize - 1) / chunkSize;
+        chunksY = (height + chunkSize - 1) / chunkSize;
+        chunks.assign(chunksX * chunksY, Chunk{});
+        for (size_t i = 0; i < chunks.size() && i < old.size(); ++i) chunks[i].texture = old[i].texture;
+        for (size_t i = chunks.size(); i < old.size(); ++i) unloadTexture(old[i].texture);
+    }
+    revision = tilemap.revision;
+    built = true;
+
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            Chunk& chunk = chunks[cy * chunksX + cx];
+            uint64_t sig = computeSignature(tilemap, cx, cy);
+            if (!resized && sig == chunk.signature) continue;
+            chunk.signature = sig;
+            upload(tilemap, cx, cy, chunk);
+        }
+    }
+}
+
+void IntGridOverlay::submit(const TileMap& tilemap, CommandBuffer& out, Rectangle view) {
+    PROFILE_ZONE("IntGridOverlay::submit");
+    sync(tilemap);
+    lastDrawn = 0;
+    if (!built) return;
+
+    const float chunkWorld = chunkSize * tilemap.tileSize * tilemap.scale;
+    const int startX = std::max(0, (int)floorf(view.x / chunkWorld));
+    const int startY = std::max(0, (int)floorf(view.y / chunkWorld));
+    const int endX = std::min(chunksX - 1, (int)floorf((view.x + view.width) / chunkWorld));
+    const int endY = std::min(chunksY - 1, (int)floorf((view.y + view.height) / chunkWorld));
+    const Rectangle src = {0, 0, (float)chunkSize, (float)chunkSize};
+    for (int cy = startY; cy <= endY; ++cy) {
+        for (int cx = startX; cx <= endX; ++cx) {
+            const Chunk& chunk = chunks[cy * chunksX + cx];
+            if (chunk.empty) continue;
+            out.quad(RenderLayer::DebugWorld, chunk.texture, src, {cx * chunkWorld, cy * chunkWorld, chunkWorld, chunkWorld}, WHITE);
+            ++lastDrawn;
+        }
+    }
+}
+
+// Firma de lo que se dibuja de cada spawner (cambia con el shift de expansión o ediciones en el Editor)
+static uint64_t spawnerSignature(ECS& ecs) {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) h = (h ^ bytes[i]) * 1099511628211ull;
+    };
+    for (auto& [entity, spawner] : ecs.getComponentMap<EnemySpawner>()) {
+        mix(&entity, sizeof(entity));
+        mix(&spawner.type, sizeof(spawner.type));
+        mix(&spawner.center, sizeof(spawner.center));
+        mix(&spawner.radius, sizeof(spawner.radius));
+        mix(&spawner.areaSize, sizeof(spawner.areaSize));
+        mix(&spawner.spacing, sizeof(spawner.spacing));
+        mix(&spawner.maxEnemies, sizeof(spawner.maxEnemies));
+    }
+    return h;
+}
+
+void SpawnerOverlay::rebuild(ECS& ecs) {
+    PROFILE_ZONE("SpawnerOverlay::rebuild");
+    lines.clear();
+    tris.clear();
+    ranges.clear();
+    const int circleSegments = 36;  // Como DrawCircleLines
+    const int dotSegments = 12;
+    for (auto& [entity, spawner] : ecs.getComponentMap<EnemySpawner>()) {
+        Range range{{}, (uint32_t)(lines.size() / 2), 0, (uint32_t)(tris.size() / 3), 0};
+        const Vector2 c = spawner.center;
+        const float halfLine = spawner.maxEnemies * spawner.spacing / 2.0f;
+        switch (spawner.type) {
+            case SpawnType::LineHorizontal:
+                lines.push_back({c.x - halfLine, c.y});
+                lines.push_back({c.x + halfLine, c.y});
+                break;
+            case SpawnType::LineVertical:
+                lines.push_back({c.x, c.y - halfLine});
+                lines.push_back({c.x, c.y + halfLine});
+                break;
+            case SpawnType::Circular:
+                for (int i = 0; i < circleSegments; ++i) {
+                    float a0 = 2.0f * PI * i / circleSegments, a1 = 2.0f * PI * (i + 1) / circleSegments;
+                    lines.push_back({c.x + cosf(a0) * spawner.radius, c.y + sinf(a0) * spawner.radius});
+                    lines.push_back({c.x + cosf(a1) * spawner.radius, c.y + sinf(a1) * spawner.radius});
+                }
+                break;
+            case SpawnType::RandomArea: {
+                const float x0 = c.x - spawner.areaSize.x / 2.0f, y0 = c.y - spawner.areaSize.y / 2.0f;
+                const float x1 = x0 + spawner.areaSize.x, y1 = y0 + spawner.areaSize.y;
+                const Vector2 corners[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+                for (int i = 0; i < 4; ++i) {
+                    lines.push_back(corners[i]);
+                    lines.push_back(corners[(i + 1) % 4]);
+                }
+                break;
+            }
+        }
+        // Punto central (disco de radio 5, CCW como DrawCircle)
+        for (int i = 0; i < dotSegments; ++i) {
+            float a0 = 2.0f * PI * i / dotSegments, a1 = 2.0f * PI * (i + 1) / dotSegments;
+            tris.push_back(c);
+            tris.push_back({c.x + cosf(a1) * 5.0f, c.y + sinf(a1) * 5.0f});
+            tris.push_back({c.x + cosf(a0) * 5.0f, c.y + sinf(a0) * 5.0f});
+        }
+        range.lineCount = (uint32_t)(lines.size() / 2) - range.lineStart;
+        range.triCount = (uint32_t)(tris.size() / 3) - range.triStart;
+
+        // Bounds de todos sus vértices (culling)
+        float minX = c.x - 5.0f, minY = c.y - 5.0f, maxX = c.x + 5.0f, maxY = c.y + 5.0f;
+        for (uint32_t i = range.lineStart * 2; i < (range.lineStart + range.lineCount) * 2; ++i) {
+            minX = std::min(minX, lines[i].x);
+            minY = std::min(minY, lines[i].y);
+            maxX = std::max(maxX, lines[i].x);
+            maxY = std::max(maxY, lines[i].y);
+        }
+        range.bounds = {minX, minY, maxX - minX, maxY - minY};
+        ranges.push_back(range);
+    }
+}
+
+static bool overlaps(const Rectangle& a, const Rectangle& b) {
+    return !(a.x > b.x + b.width || a.x + a.width < b.x || a.y > b.y + b.height || a.y + a.height < b.y);
+}
+
+void SpawnerOverlay::submit(ECS& ecs, CommandBuffer& out, Rectangle view) {
+    PROFILE_ZONE("SpawnerOverlay::submit");
+    uint64_t sig = spawnerSignature(ecs);
+    if (sig != signature) {
+        rebuild(ecs);
+        signature = sig;
+    }
+    visibleLines.clear();
+    visibleTris.clear();
+    for (const Range& range : ranges) {
+        if (!overlaps(range.bounds, view)) continue;
+        visibleLines.insert(visibleLines.end(), lines.begin() + range.lineStart * 2, lines.begin() + (range.lineStart + range.lineCount) * 2);
+        visibleTris.insert(visibleTris.end(), tris.begin() + range.triStart * 3, tris.begin() + (range.triStart + range.triCount) * 3);
+    }
+    // Encima de los quads del layer (depth 1); líneas antes que los centros (misma key: orden de submit)
+    out.lines(RenderLayer::DebugWorld, visibleLines.data(), (uint32_t)visibleLines.size(), 2.0f, {YELLOW.r, YELLOW.g, YELLOW.b, 128}, 1);
+    out.triangles(RenderLayer::DebugWorld, visibleTris.data(), (uint32_t)visibleTris.size(), RED, 1);
+}
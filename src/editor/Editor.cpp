@@ -4,14 +4,26 @@
 #include <imgui.h>
 #include <string>
 #include <AdventureScene.h>
+#include <StressScene.h>
+#include "../profiler.h"
+#include "../memstats.h"
+#include "../renderqueue.h"
+#include "../chunksummary.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
 
 Editor::Editor(bool& paused_ref) : paused(paused_ref) {}
 
-void Editor::renderGUI(Scene* currentScene) {
+void Editor::renderGUI(Scene* currentScene, const RenderQueue* renderQueue) {
     if (!currentScene) return;
     ECS& ecs = currentScene->getECS();
 
     drawControls();
+    drawProfiler();
+    drawMemory(ecs);
+    if (renderQueue) drawRenderQueue(*renderQueue);
     drawEntityList(ecs);
     if (selectedEntity != -1) {
         drawInspector(ecs);
@@ -19,7 +31,240 @@ void Editor::renderGUI(Scene* currentScene) {
 
     if (auto* advScene = dynamic_cast<AdventureScene*>(currentScene)) {
         ImGui::Checkbox("Debug Spawners", &advScene->debugSpawners);
+        drawAILod(advScene->aiLod);
+        drawCulling(advScene->spriteCuller);
+        drawChunkLod(ecs, advScene->chunkSummaries, &advScene->showMinimap);
     }
+    if (auto* stress = dynamic_cast<StressScene*>(currentScene)) {
+        drawStress(*stress);
+        drawCulling(stress->spriteCuller);
+        drawChunkLod(ecs, stress->chunkSummaries, nullptr);
+    }
+}
+
+
+void Editor::drawAILod(AILodScheduler& lod) {
+    ImGui::Begin("AI LOD", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    const AILodStats& stats = lod.getStats();
+    static const char* names[4] = {"Near", "Mid", "Far", "Dormant"};
+    double total = 0.0;
+    for (int b = 0; b < 4; ++b) {
+        ImGui::Text("%-8s %6d entities  %6d ticks  %.3f ms", names[b], stats.counts[b], stats.updated[b], stats.costMs[b]);
+        total += stats.costMs[b];
+    }
+    ImGui::Text("Total AI: %.3f ms  (deferred: %d)", total, stats.deferred);
+
+    ImGui::Separator();
+    ImGui::SliderFloat("Near dist", &lod.config.nearDistance, 100.0f, 5000.0f);
+    ImGui::SliderFloat("Mid dist", &lod.config.midDistance, 100.0f, 10000.0f);
+    ImGui::SliderFloat("Dormant dist", &lod.config.dormantDistance, 100.0f, 20000.0f);
+    ImGui::SliderInt("Mid interval", &lod.config.midInterval, 1, 16);
+    ImGui::SliderInt("Far interval", &lod.config.farInterval, 1, 60);
+    ImGui::InputInt("Deferred budget", &lod.config.maxDeferredUpdates);
+    ImGui::SliderFloat("Max tick dt", &lod.config.maxTickDt, 0.02f, 1.0f);
+    ImGui::End();
+}
+
+
+void Editor::drawCulling(const SpriteCuller& culler) {
+    ImGui::Begin("Sprite Culling", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    const CullStats& stats = culler.stats;
+    ImGui::Text("Drawn %6d / %6d sprites  (culled %d)", stats.drawn, stats.total, stats.culled);
+    ImGui::Text("Grid candidates %d  %s", stats.candidates, stats.cached ? "(cached)" : "");
+    ImGui::Text("Grid rebuilds: %d  movers %d  relocated %d", stats.rebuilds, stats.movers, stats.relocated);
+    ImGui::End();
+}
+
+
+void Editor::drawChunkLod(ECS& ecs, ChunkSummaries& summaries, bool* showMinimap) {
+    ImGui::Begin("Chunk LOD", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    // Zoom de la cámara activa (la primera, como systemRenderTileMap)
+    for (auto& [entity, camComp] : ecs.getComponentMap<CameraComp>()) {
+        ImGui::SliderFloat("Zoom", &camComp.cam.zoom, 0.005f, 2.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
+        for (auto& [mapEnt, tilemap] : ecs.getComponentMap<TileMap>()) {
+            ImGui::Text("Level %d  (0 = tiles)", summaries.levelForZoom(tilemap, camComp.cam.zoom));
+        }
+        break;
+    }
+    ImGui::SliderFloat("LOD bias", &summaries.lodBias, -1.0f, 1.0f);
+    if (showMinimap) ImGui::Checkbox("Minimap", showMinimap);
+    ImGui::Text("Chunks %d  drawn %d  rebuilt %d  tile samples %d", summaries.getChunkCount(), summaries.getLastDrawn(),
+                summaries.getLastRebuilds(), summaries.getSampleCount());
+    ImGui::End();
+}
+
+
+void Editor::drawRenderQueue(const RenderQueue& queue) {
+    ImGui::Begin("Render Queue", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    const RenderQueueStats& stats = queue.getStats();
+    ImGui::Text("Commands %6d  (segments %d, parallel ranges %d)", stats.commands, stats.segments, stats.parallelRanges);
+    ImGui::Text("Texture switches %d  radix passes %d", stats.textureSwitches, stats.sortPasses);
+    ImGui::End();
+}
+
+
+void Editor::drawProfiler() {
+    ImGui::Begin("Profiler");
+#ifndef GAME_PROFILE
+    ImGui::TextUnformatted("Compilado sin GAME_PROFILE");
+#else
+    Profiler& prof = Profiler::instance();
+    const std::vector<float>& frames = prof.getFrameTimes();
+    if (!frames.empty()) {
+        // Histograma de frame time: 0..33 ms en buckets de 1 ms (el último acumula el resto)
+        float buckets[34] = {};
+        for (float ms : frames) buckets[std::min(33, (int)ms)] += 1.0f;
+        ImGui::Text("Frame: %.2f ms", frames.back());
+        ImGui::PlotLines("##frametime", frames.data(), (int)frames.size(), 0, "frame ms", 0.0f, 33.3f, ImVec2(0, 50));
+        ImGui::PlotHistogram("##framehist", buckets, 34, 0, "histograma (1 ms/bucket)", 0.0f, 3.4e38f, ImVec2(0, 50));
+    }
+
+    // Timeline del último frame: una fila por thread, una barra por zona (alto = profundidad)
+    if (ImGui::CollapsingHeader("Timeline", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const float rowHeight = 14.0f;
+        const int threads = std::max(1, prof.getThreadCount());
+        int maxDepth = 1;
+        for (const ProfileEvent& ev : prof.getLastFrame()) maxDepth = std::max(maxDepth, (int)ev.depth + 1);
+        const float threadHeight = rowHeight * maxDepth + 4.0f;
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float width = std::max(100.0f, ImGui::GetContentRegionAvail().x);
+        ImDrawList* draw = ImGui::GetWindowDrawList();
+        uint64_t frameStart = prof.getLastFrameStart();
+        double frameMs = std::max(0.001, prof.ticksToMs(prof.getLastFrameEnd() - frameStart));
+
+        for (const ProfileEvent& ev : prof.getLastFrame()) {
+            double startMs = ev.start > frameStart ? prof.ticksToMs(ev.start - frameStart) : 0.0;
+            double durMs = prof.ticksToMs(ev.end - ev.start);
+            float x0 = origin.x + (float)(startMs / frameMs) * width;
+            float x1 = std::max(x0 + 1.0f, origin.x + (float)((startMs + durMs) / frameMs) * width);
+            float y0 = origin.y + ev.thread * threadHeight + ev.depth * rowHeight;
+            ImVec2 a(x0, y0), b(std::min(x1, origin.x + width), y0 + rowHeight - 1.0f);
+            // Color estable por nombre
+            unsigned int hash = 2166136261u;
+            for (const char* c = ev.name; *c; ++c) hash = (hash ^ (unsigned char)*c) * 16777619u;
+            draw->AddRectFilled(a, b, IM_COL32(80 + hash % 150, 80 + (hash >> 8) % 150, 80 + (hash >> 16) % 150, 255));
+            if (b.x - a.x > 40.0f) draw->AddText(ImVec2(a.x + 2, a.y), IM_COL32(0, 0, 0, 255), ev.name);
+            if (ImGui::IsMouseHoveringRect(a, b)) ImGui::SetTooltip("%s\n%.3f ms", ev.name, durMs);
+        }
+        ImGui::Dummy(ImVec2(width, threads * threadHeight));
+    }
+
+    if (ImGui::CollapsingHeader("Zonas", ImGuiTreeNodeFlags_DefaultOpen) &&
+        ImGui::BeginTable("zones", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Zona");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Min");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableSetupColumn("P99");
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Avg allocs");
+        ImGui::TableHeadersRow();
+        for (const ProfileZoneStats& zone : prof.getZones()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(zone.name);
+            ImGui::TableNextColumn(); ImGui::Text("%d", zone.calls);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.lastMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.minMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.avgMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.p99Ms);
+            ImGui::TableNextColumn(); ImGui::Text("%d", zone.allocs);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", zone.avgAllocs);
+        }
+        ImGui::EndTable();
+    }
+
+    // Captura -> Chrome trace (abrir en chrome://tracing o ui.perfetto.dev)
+    if (prof.isCapturing()) {
+        ImGui::Text("Capturando... (%zu eventos)", prof.getCapturedEvents());
+    } else {
+        if (ImGui::Button("Capturar 120 frames")) prof.startCapture(120);
+        ImGui::SameLine();
+        if (prof.getCapturedEvents() > 0 && ImGui::Button("Exportar profile_trace.json")) {
+            prof.exportChromeTrace("profile_trace.json");
+        }
+    }
+#endif
+    ImGui::End();
+}
+
+
+void Editor::drawMemory(ECS& ecs) {
+    ImGui::Begin("Memory");
+    const FrameAllocStats& frame = frameAllocStats();
+    if (!allocHooksInstalled()) ImGui::TextUnformatted("Sin hooks de allocations (GAME_ALLOC_HOOKS=OFF)");
+    ImGui::Text("Allocs/frame: %llu (%llu bytes)  avg %.1f  max %llu", (unsigned long long)frame.last,
+                (unsigned long long)frame.lastBytes, frame.avg, (unsigned long long)frame.max);
+    ImGui::PlotHistogram("##allocs", frame.history, FrameAllocStats::kHistory, 0, "allocs por frame", 0.0f, 3.4e38f, ImVec2(0, 40));
+
+    static MemoryReport report;  // Reusado: no alloca por frame salvo que crezca la lista
+    collectMemoryReport(ecs, report);
+    ImGui::Text("Heap vivo: %.2f MB  (%llu allocs / %llu frees)", report.allocs.liveBytes / (1024.0 * 1024.0),
+                (unsigned long long)report.allocs.allocs, (unsigned long long)report.allocs.frees);
+    ImGui::Text("TileMap: %zu tiles, %.2f MB", report.tileCount, report.tileMapBytes / (1024.0 * 1024.0));
+    ImGui::Text("Texturas: %d, %.2f MB", report.textureCount, report.textureBytes / (1024.0 * 1024.0));
+
+    if (ImGui::BeginTable("pools", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Component");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("KB");
+        ImGui::TableHeadersRow();
+        for (const ComponentMemory& m : report.components) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(m.name);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", m.count);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", m.bytes / 1024.0);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::Text("Total components: %.1f KB", report.componentBytes / 1024.0);
+    ImGui::End();
+}
+
+
+void Editor::drawStress(StressScene& stress) {
+    ImGui::Begin("Stress", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    StressConfig& cfg = stress.config;
+    ImGui::SliderInt("Sprites", &cfg.sprites, 0, 100000);
+    ImGui::SliderInt("Tracking", &cfg.tracking, 0, 50000);
+    ImGui::SliderInt("Circular", &cfg.circular, 0, 50000);
+    ImGui::SliderInt("Patrol", &cfg.patrol, 0, 50000);
+    ImGui::SliderInt("Spawners", &cfg.spawners, 0, 500);
+    ImGui::Checkbox("Ramp", &cfg.ramp);
+    ImGui::SameLine();
+    ImGui::SliderFloat("x cada", &cfg.rampInterval, 0.5f, 10.0f, "%.1f s");
+    ImGui::SliderFloat("Factor", &cfg.rampFactor, 1.1f, 3.0f);
+
+    const StressSample& cur = stress.getCurrent();
+    float sim = cur.frames ? cur.simMs / cur.frames : 0.0f;
+    ImGui::Text("Entities: %d  sim %.3f ms  (%.0f entities/ms)", stress.getEntityCount(), sim, sim > 0 ? stress.getEntityCount() / sim : 0.0f);
+    const AIBatch& ai = stress.aiBatch;
+    ImGui::Text("AI lanes: tracking %d  circular %d  patrol %d  (rebuilds %d)", ai.getCount(MovementType::Tracking),
+                ai.getCount(MovementType::Circular), ai.getCount(MovementType::Patrol), ai.getRebuilds());
+
+    // Curva frame time vs count (un punto por set de counts)
+    const std::vector<StressSample>& curve = stress.getCurve();
+    if (!curve.empty()) {
+        static std::vector<float> simCurve;
+        simCurve.clear();
+        for (const StressSample& s : curve) simCurve.push_back(s.simMs);
+        ImGui::PlotLines("##curve", simCurve.data(), (int)simCurve.size(), 0, "sim ms por punto", 0.0f, 3.4e38f, ImVec2(300, 80));
+        if (ImGui::BeginTable("curve", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            for (const char* col : {"Entities", "Sim", "AI", "Move", "Anim", "Spawn", "Render"}) ImGui::TableSetupColumn(col);
+            ImGui::TableHeadersRow();
+            for (const StressSample& s : curve) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%d", s.entities);
+                for (float ms : {s.simMs, s.aiMs, s.movementMs, s.animationMs, s.spawnMs, s.renderMs}) {
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", ms);
+                }
+            }
+            ImGui::EndTable();
+        }
+        if (ImGui::Button("Limpiar curva")) stress.clearCurve();
+    }
+    ImGui::End();
 }
 
 
@@ -33,44 +278,108 @@ void Editor::drawControls() {
 }
 
 
+// Rol legible por máscara (primera coincidencia); también es alias para la búsqueda
+static const struct { const char* name; uint32_t bit; } kEntityRoles[] = {
+    {"Player", componentBit<InputControlled>}, {"Spawner", componentBit<EnemySpawner>}, {"Enemy", componentBit<MovementPattern>},
+    {"TileMap", componentBit<TileMap>}, {"Camera", componentBit<CameraComp>}, {"Paddle", componentBit<PaddleControlled>},
+    {"AI", componentBit<AIPatrol>}, {"Sprite", componentBit<Sprite>},
+};
+
+static const char* entityRole(uint32_t mask) {
+    for (const auto& role : kEntityRoles) {
+        if (mask & role.bit) return role.name;
+    }
+    return "";
+}
+
+static bool containsNoCase(const char* text, const char* term) {
+    for (; *text; ++text) {
+        const char *a = text, *b = term;
+        while (*a && *b && tolower((unsigned char)*a) == tolower((unsigned char)*b)) ++a, ++b;
+        if (!*b) return true;
+    }
+    return false;
+}
+
+void Editor::rebuildEntityFilter(ECS& ecs) {
+    const EntityIndex& index = ecs.getEntityIndex();
+    filteredEntities.clear();
+
+    // Búsqueda: número = substring del id; texto = components/roles cuyo nombre lo contiene
+    bool numeric = entitySearch[0] != '\0';
+    for (const char* c = entitySearch; *c; ++c) numeric = numeric && isdigit((unsigned char)*c);
+    uint32_t searchMask = 0;
+    if (entitySearch[0] && !numeric) {
+        for (int i = 0; i < kComponentBitCount; ++i) {
+            if (containsNoCase(kComponentNames[i], entitySearch)) searchMask |= 1u << i;
+        }
+        for (const auto& role : kEntityRoles) {
+            if (containsNoCase(role.name, entitySearch)) searchMask |= role.bit;
+        }
+    }
+
+    char idText[24];
+    for (Entity e : index.dense) {
+        uint32_t mask = index.mask(e);
+        if ((mask & entityFilterMask) != entityFilterMask) continue;
+        if (numeric) {
+            snprintf(idText, sizeof(idText), "%zu", e);
+            if (!strstr(idText, entitySearch)) continue;
+        } else if (entitySearch[0] && !(mask & searchMask)) {
+            continue;
+        }
+        filteredEntities.push_back(e);
+    }
+}
+
 void Editor::drawEntityList(ECS& ecs) {
     ImGui::Begin("Entities");
-    ImGui::Text("Active Entities: %zu", ecs.getAllEntities().size());  // Count dinámico
+    const EntityIndex& index = ecs.getEntityIndex();
+    ImGui::Text("Active Entities: %zu", index.dense.size());  // Count dinámico (índice incremental)
 
-    // Categorías genéricas por component (expansible)
-    if (ImGui::TreeNode("Players (InputControlled)")) {
-        for (auto& [e, _] : ecs.getComponentMap<InputControlled>()) {
-            std::string label = "Player Entity " + std::to_string(e);
-            if (ImGui::Selectable(label.c_str(), selectedEntity == e)) {
-                selectedEntity = e;
-            }
+    if (ImGui::TreeNode("Filters")) {
+        for (int i = 0; i < kComponentBitCount; ++i) {
+            if (i % 3 != 0) ImGui::SameLine(150.0f * (i % 3));
+            ImGui::CheckboxFlags(kComponentNames[i], &entityFilterMask, 1u << i);
         }
+        if (ImGui::Button("Clear filters")) entityFilterMask = 0;
         ImGui::TreePop();
     }
+    ImGui::InputTextWithHint("##search", "id, component o rol (player, enemy...)", entitySearch, sizeof(entitySearch));
 
-    if (ImGui::TreeNode("AI Entities (AIPatrol)")) {
-        for (auto& [e, _] : ecs.getComponentMap<AIPatrol>()) {
-            std::string label = "AI Entity " + std::to_string(e);
-            if (ImGui::Selectable(label.c_str(), selectedEntity == e)) {
-                selectedEntity = e;
-            }
+    const bool filtering = entityFilterMask != 0 || entitySearch[0] != '\0';
+    if (filtering) {
+        const bool criteriaChanged = filteredMask != entityFilterMask || strcmp(filteredSearch, entitySearch) != 0 ||
+                                     filteredIndex != &index;
+        const double now = ImGui::GetTime();
+        if (criteriaChanged || (filteredVersion != index.version && now - filteredTime > 0.25)) {
+            rebuildEntityFilter(ecs);
+            filteredMask = entityFilterMask;
+            memcpy(filteredSearch, entitySearch, sizeof(filteredSearch));
+            filteredVersion = index.version;
+            filteredIndex = &index;
+            filteredTime = now;
         }
-        ImGui::TreePop();
     }
+    const std::vector<Entity>& rows = filtering ? filteredEntities : index.dense;
+    ImGui::Text("Shown: %zu", rows.size());
 
-    // Fallback: Lista all si no matches (para Breakout legacy)
-    if (ImGui::TreeNode("Other Entities")) {
-        auto allEntities = ecs.getAllEntities();
-        for (Entity e : allEntities) {
-            // Skip si ya en categorías arriba
-            if (ecs.hasComponent<InputControlled>(e) || ecs.hasComponent<AIPatrol>(e)) continue;
-            std::string label = "Entity " + std::to_string(e);
-            if (ImGui::Selectable(label.c_str(), selectedEntity == e)) {
+    // Solo se formatean/dibujan las filas visibles
+    ImGui::BeginChild("EntityRows");
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rows.size());
+    char label[64];
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            Entity e = rows[i];
+            snprintf(label, sizeof(label), "Entity %zu  %s", e, entityRole(index.mask(e)));
+            if (ImGui::Selectable(label, selectedEntity == e)) {
                 selectedEntity = e;
             }
         }
-        ImGui::TreePop();
     }
+    clipper.End();
+    ImGui::EndChild();
 
     ImGui::End();
 }
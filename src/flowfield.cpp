@@ -0,0 +1,183 @@
+// src/flowfield.cpp
+#include "flowfield.h"
+#include "profiler.h"
+#include "replay.h"
+#include <cmath>
+#include <utility>
+
+// 8 direcciones (mismo orden que dx/dy del autotiling)
+static const int fdx[8] = { -1,  0,  1, -1, 1, -1, 0, 1 };
+static const int fdy[8] = { -1, -1, -1,  0, 0,  1, 1, 1 };
+
+FlowField::FlowField() : worker(&FlowField::workerLoop, this) {}
+
+FlowField::~FlowField() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    cv.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+void FlowField::publish() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!fieldReady) return;
+    std::swap(front, ready);  // Swap de vectors, sin copias
+    fieldReady = false;
+    ++generation;
+}
+
+void FlowField::requestIfChanged(const TileMap& tilemap, Vector2 goalWorld) {
+    publish();
+    if (tilemap.tiles.size() != (size_t)(tilemap.width * tilemap.height)) return;
+
+    const float tileWorld = tilemap.tileSize * tilemap.scale;
+    int gx = (int)floorf(goalWorld.x / tileWorld);
+    int gy = (int)floorf(goalWorld.y / tileWorld);
+
+    if (hasRequest && gx == lastGoalX && gy == lastGoalY && tilemap.width == lastWidth &&
+        tilemap.height == lastHeight && tilemap.revision == lastRevision) {
+        return;  // Nada cambió: el field actual sigue válido
+    }
+    hasRequest = true;
+    lastGoalX = gx;
+    lastGoalY = gy;
+    lastWidth = tilemap.width;
+    lastHeight = tilemap.height;
+    lastRevision = tilemap.revision;
+
+    {
+        // Snapshot compacto (1 byte por tile) para no compartir tiles con el worker
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.width = tilemap.width;
+        pending.height = tilemap.height;
+        pending.tileWorld = tileWorld;
+        pending.revision = tilemap.revision;
+        pending.goalX = gx;
+        pending.goalY = gy;
+        pending.solid.resize(tilemap.tiles.size());
+        for (size_t i = 0; i < tilemap.tiles.size(); ++i) {
+            pending.solid[i] = tilemap.tiles[i].value == IntGridValue::NON_WALKABLE;
+        }
+        if (isDeterministic()) {
+            // Replay: publica en este mismo tick (el worker no queda con trabajo pendiente)
+            compute(pending, front, syncQueue);
+            fieldReady = false;
+            ++generation;
+            return;
+        }
+        jobReady = true;  // Si había uno sin procesar, se reemplaza (solo importa el último)
+    }
+    cv.notify_one();
+}
+
+void FlowField::workerLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return jobReady || quit; });
+            if (quit) return;
+            std::swap(working, pending);
+            jobReady = false;
+        }
+
+        compute(working, back, workerQueue);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(ready, back);  // Queda para el próximo publish (si había uno sin publicar, se descarta)
+        fieldReady = true;
+    }
+}
+
+void FlowField::compute(const Job& job, Field& out, std::vector<int32_t>& queue) {
+    PROFILE_ZONE("FlowField::compute");
+    const int w = job.width, h = job.height;
+    out.width = w;
+    out.height = h;
+    out.tileWorld = job.tileWorld;
+    out.revision = job.revision;
+    out.dist.assign((size_t)w * h, -1);
+    out.dir.assign((size_t)w * h, kNoDir);
+
+    if (job.goalX < 0 || job.goalX >= w || job.goalY < 0 || job.goalY >= h) return;
+
+    auto solid = [&](int x, int y) {
+        return x < 0 || x >= w || y < 0 || y >= h || job.solid[y * w + x];
+    };
+
+    // BFS 4-vecinos (integration field). La cola conserva capacidad: sin allocations salvo que crezca el mapa
+    queue.clear();
+    queue.reserve((size_t)w * h);
+    int goal = job.goalY * w + job.goalX;
+    out.dist[goal] = 0;
+    queue.push_back(goal);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int idx = queue[head];
+        int x = idx % w, y = idx / w;
+        static const int ndx[4] = {1, -1, 0, 0};
+        static const int ndy[4] = {0, 0, 1, -1};
+        for (int k = 0; k < 4; ++k) {
+            int nx = x + ndx[k], ny = y + ndy[k];
+            if (solid(nx, ny)) continue;
+            int nIdx = ny * w + nx;
+            if (out.dist[nIdx] != -1) continue;
+            out.dist[nIdx] = out.dist[idx] + 1;
+            queue.push_back(nIdx);
+        }
+    }
+
+    // Dirección: vecino (8 dirs) con menor distancia, sin cortar esquinas de muros
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int idx = y * w + x;
+            if (out.dist[idx] <= 0) continue;  // Goal o inalcanzable
+            int best = out.dist[idx];
+            int8_t bestDir = kNoDir;
+            for (int i = 0; i < 8; ++i) {
+                int nx = x + fdx[i], ny = y + fdy[i];
+                if (solid(nx, ny)) continue;
+                if (fdx[i] != 0 && fdy[i] != 0 && (solid(x + fdx[i], y) || solid(x, y + fdy[i]))) continue;
+                int d = out.dist[ny * w + nx];
+                if (d >= 0 && d < best) {
+                    best = d;
+                    bestDir = (int8_t)i;
+                }
+            }
+            out.dir[idx] = bestDir;
+        }
+    }
+}
+
+bool FlowField::sample(Vector2 worldPos, Vector2& outDir) const {
+    if (front.width == 0) return false;
+
+    int tx = (int)floorf(worldPos.x / front.tileWorld);
+    int ty = (int)floorf(worldPos.y / front.tileWorld);
+    if (tx < 0 || tx >= front.width || ty < 0 || ty >= front.height) return false;
+
+    int8_t d = front.dir[ty * front.width + tx];
+    if (d == kNoDir) return false;
+
+    // Apunta al centro del tile vecino (evita rozar esquinas)
+    float cx = (tx + fdx[d] + 0.5f) * front.tileWorld;
+    float cy = (ty + fdy[d] + 0.5f) * front.tileWorld;
+    Vector2 v = {cx - worldPos.x, cy - worldPos.y};
+    float len = sqrtf(v.x * v.x + v.y * v.y);
+    if (len <= 0.0f) return false;
+    outDir = {v.x / len, v.y / len};
+    return true;
+}
+
+bool FlowField::matches(const TileMap& tilemap) const {
+    return front.width == tilemap.width && front.height == tilemap.height && front.revision == tilemap.revision;
+}
+
+int FlowField::getDistance(int tx, int ty) const {
+    if (tx < 0 || tx >= front.width || ty < 0 || ty >= front.height) return -1;
+    return front.dist[ty * front.width + tx];
+}
+
+uint64_t FlowField::getGeneration() const {
+    return generation.load();
+}
@@ -0,0 +1,189 @@
+// src/headless.cpp
+#include "headless.h"
+#include "platform.h"
+#include "Scene.h"
+#include "components.h"
+#include "systems.h"
+#include "profiler.h"
+#include "memstats.h"
+#include "replay.h"
+#include <raylib.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+
+// Script de input: tramos de 90 ticks, sesgado a derecha/abajo para forzar expansión del mapa
+static void applyWanderInput(int tick) {
+    static const int keys[] = {KEY_RIGHT, KEY_DOWN, KEY_RIGHT, KEY_UP, KEY_LEFT, KEY_DOWN};
+    const int count = sizeof(keys) / sizeof(keys[0]);
+    int active = keys[(tick / 90) % count];
+    for (int key : {KEY_RIGHT, KEY_LEFT, KEY_UP, KEY_DOWN}) setStubKey(key, key == active);
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static void printMemoryReport(const MemoryReport& memory) {
+    std::cout << "Memory:" << std::endl;
+    for (const ComponentMemory& m : memory.components) {
+        if (m.count == 0) continue;
+        printf("  %-18s %8zu x  %10zu bytes\n", m.name, m.count, m.bytes);
+    }
+    printf("  components total   %10zu bytes\n", memory.componentBytes);
+    printf("  tilemap            %10zu bytes (%zu tiles)\n", memory.tileMapBytes, memory.tileCount);
+    printf("  textures           %10zu bytes (%d)\n", memory.textureBytes, memory.textureCount);
+    printf("  heap live          %10lld bytes (%llu allocs / %llu frees)\n", (long long)memory.allocs.liveBytes,
+           (unsigned long long)memory.allocs.allocs, (unsigned long long)memory.allocs.frees);
+}
+
+HeadlessReport runHeadless(HeadlessConfig& config) {
+    using Clock = std::chrono::steady_clock;
+    HeadlessReport report;
+
+    // Replay: la escena, el dt, la seed y el input salen del archivo
+    Replay replay;
+    const bool replaying = !config.replayPath.empty();
+    const bool recording = !replaying && !config.recordPath.empty();
+    if (replaying) {
+        if (!loadReplay(config.replayPath, replay)) return report;
+        config.scene = replay.scene;
+        config.ticks = (int)replay.input.size();
+        config.dt = replay.dt;
+        config.width = replay.width;
+        config.height = replay.height;
+        config.wander = false;
+        setSessionSeed(replay.seed);
+    } else if (recording) {
+        replay.scene = config.scene;
+        replay.seed = sessionSeed();
+        replay.dt = config.dt;
+        replay.width = config.width;
+        replay.height = config.height;
+        replay.input.reserve(config.ticks);
+        replay.hashes.reserve(config.ticks);
+    }
+    setDeterministic(replaying || recording);
+
+    setHeadless(true);
+    SetTraceLogLevel(LOG_WARNING);  // LoadImage de cada textura spamea INFO
+
+    std::unique_ptr<Scene> scene = createScene(config.scene, config.width, config.height);
+    if (!scene) return report;
+
+    auto t0 = Clock::now();
+    scene->setup();
+    report.setupMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    std::vector<double> tickMs;
+    tickMs.reserve(config.ticks);
+    uint64_t steadyAllocs = 0;
+    int steadyTicks = 0;
+    uint64_t rolling = 0;
+    int ticksRun = 0;
+    for (int tick = 0; tick < config.ticks; ++tick) {
+        if (replaying) applyInputMask(replay.input[tick]);
+        else if (config.wander) applyWanderInput(tick);
+        if (recording) replay.input.push_back(stubInputMask());
+
+        auto start = Clock::now();
+        systemSnapshotPositions(scene->getECS());
+        scene->update(config.dt);
+        tickMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        PROFILE_FRAME_END();
+        memstatsEndFrame();
+        ++ticksRun;
+
+        // Hash fuera del tiempo medido: no ensucia las stats del tick
+        if (replaying || recording) {
+            rolling = chainHash(rolling, hashState(scene->getECS()));
+            uint32_t hash = (uint32_t)rolling;
+            if (recording) replay.hashes.push_back(hash);
+            if (replaying && tick < (int)replay.hashes.size() && hash != replay.hashes[tick]) {
+                report.divergedTick = tick;
+                std::cerr << "Replay diverged at tick " << tick << ": hash " << std::hex << hash
+                          << " != recorded " << replay.hashes[tick] << std::dec << std::endl;
+                break;
+            }
+        }
+
+        if (tick >= config.warmupTicks) {
+            uint64_t allocs = frameAllocStats().last;
+            steadyAllocs += allocs;
+            ++steadyTicks;
+            if (allocs > report.maxAllocs || report.maxAllocsTick < 0) {
+                report.maxAllocs = allocs;
+                report.maxAllocsTick = tick;
+            }
+        }
+
+        advanceStubInput();
+    }
+
+    report.avgAllocs = steadyTicks ? (double)steadyAllocs / steadyTicks : 0.0;
+    report.budgetExceeded = config.allocBudget >= 0 && steadyTicks > 0 && report.maxAllocs > (uint64_t)config.allocBudget;
+
+    MemoryReport memory;
+    collectMemoryReport(scene->getECS(), memory);
+    printMemoryReport(memory);
+
+    report.finalHash = (uint32_t)rolling;
+    if (recording && saveReplay(config.recordPath, replay)) {
+        std::cout << "Replay saved: " << config.recordPath << " (" << replay.input.size() << " ticks, seed " << replay.seed << ")" << std::endl;
+    }
+    setDeterministic(false);
+
+    report.ok = !report.budgetExceeded && report.divergedTick < 0;
+    if (config.allocBudget >= 0 && !allocHooksInstalled()) {
+        std::cerr << "--alloc-budget sin hooks de allocations (GAME_ALLOC_HOOKS=OFF): no se puede chequear" << std::endl;
+        report.ok = false;  // Un chequeo que siempre ve 0 no es un chequeo
+    }
+    report.ticks = ticksRun;
+    report.entities = scene->getECS().getComponentMap<Position>().size();
+    for (double ms : tickMs) report.totalMs += ms;
+    if (!tickMs.empty()) {
+        report.avgMs = report.totalMs / tickMs.size();
+        std::sort(tickMs.begin(), tickMs.end());
+        report.p50Ms = percentile(tickMs, 0.50);
+        report.p95Ms = percentile(tickMs, 0.95);
+        report.p99Ms = percentile(tickMs, 0.99);
+        report.maxMs = tickMs.back();
+    }
+
+    scene->clean();
+    return report;
+}
+
+void printHeadlessReport(const HeadlessConfig& config, const HeadlessReport& report) {
+    if (report.ticks == 0) {
+        std::cerr << "Headless run failed for scene: " << config.scene << std::endl;
+        return;
+    }
+    std::cout << "Headless " << config.scene << ": " << report.ticks << " ticks @ " << config.dt * 1000.0f << " ms" << std::endl;
+    std::cout << "  setup   " << report.setupMs << " ms" << std::endl;
+    std::cout << "  total   " << report.totalMs << " ms (" << (report.totalMs > 0 ? report.ticks * 1000.0 / report.totalMs : 0.0) << " ticks/s)" << std::endl;
+    std::cout << "  tick    avg " << report.avgMs << " | p50 " << report.p50Ms << " | p95 " << report.p95Ms
+              << " | p99 " << report.p99Ms << " | max " << report.maxMs << " ms" << std::endl;
+    std::cout << "  entities " << report.entities << std::endl;
+    std::cout << "  allocs/tick (después de " << config.warmupTicks << " ticks) avg " << report.avgAllocs
+              << " | max " << report.maxAllocs << " (tick " << report.maxAllocsTick << ")" << std::endl;
+    if (!config.replayPath.empty()) {
+        if (report.divergedTick < 0) std::cout << "  replay  OK, final hash " << std::hex << report.finalHash << std::dec << std::endl;
+        else std::cout << "  replay  DIVERGED at tick " << report.divergedTick << std::endl;
+    }
+    if (report.budgetExceeded) {
+        std::cerr << "Alloc budget exceeded: " << report.maxAllocs << " > " << config.allocBudget
+                  << " allocations en tick " << report.maxAllocsTick << std::endl;
+    }
+
+#ifdef GAME_PROFILE
+    // Zonas del profiler (ventana rodante de los últimos ticks)
+    for (const ProfileZoneStats& zone : Profiler::instance().getZones()) {
+        printf("  %-28s avg %8.4f | min %8.4f | p99 %8.4f ms\n", zone.name, zone.avgMs, zone.minMs, zone.p99Ms);
+    }
+#endif
+}
@@ -0,0 +1,389 @@
+// src/hpa.cpp
+#include "hpa.h"
+#include "profiler.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+
+// Lados: 0=N, 1=E, 2=S, 3=W
+static const int sideDx[4] = { 0, 1, 0, -1 };
+static const int sideDy[4] = { -1, 0, 1, 0 };
+
+bool ChunkPathfinder::isSolid(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return true;
+    return solid[y * width + x] != 0;
+}
+
+int ChunkPathfinder::chunkOf(int tile) const {
+    return ((tile / width) / chunkSize) * chunksX + (tile % width) / chunkSize;
+}
+
+void ChunkPathfinder::chunkBounds(int chunk, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = (chunk % chunksX) * chunkSize;
+    y0 = (chunk / chunksX) * chunkSize;
+    x1 = std::min(width, x0 + chunkSize) - 1;
+    y1 = std::min(height, y0 + chunkSize) - 1;
+}
+
+// Chunks sin nodos comparten base: upper_bound - 1 da el último con base <= id, que es el dueño
+int ChunkPathfinder::ownerChunk(int id) const {
+    return (int)(std::upper_bound(nodeBase.begin(), nodeBase.end(), id) - nodeBase.begin()) - 1;
+}
+
+int ChunkPathfinder::localIndex(int chunk, int tile) const {
+    int x0, y0, x1, y1;
+    chunkBounds(chunk, x0, y0, x1, y1);
+    return (tile / width - y0) * chunkSize + (tile % width - x0);
+}
+
+uint64_t ChunkPathfinder::computeSignature(int chunk) const {
+    int x0, y0, x1, y1;
+    chunkBounds(chunk, x0, y0, x1, y1);
+    uint64_t h = 1469598103934665603ull;  // FNV-1a
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            h = (h ^ solid[y * width + x]) * 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+void ChunkPathfinder::sync(const TileMap& tilemap) {
+    PROFILE_ZONE("ChunkPathfinder::sync");
+    if (tilemap.tiles.size() != (size_t)(tilemap.width * tilemap.height)) return;
+    bool resized = !built || tilemap.width != width || tilemap.height != height || tilemap.chunkSize != chunkSize;
+    if (!resized && tilemap.revision == revision) return;
+
+    width = tilemap.width;
+    height = tilemap.height;
+    chunkSize = tilemap.chunkSize;
+    tileWorld = tilemap.tileSize * tilemap.scale;
+    revision = tilemap.revision;
+    built = true;
+
+    solid.resize(tilemap.tiles.size());
+    for (size_t i = 0; i < tilemap.tiles.size(); ++i) {
+        solid[i] = tilemap.tiles[i].value == IntGridValue::NON_WALKABLE;
+    }
+
+    chunksX = (width + chunkSize - 1) / chunkSize;
+    chunksY = (height + chunkSize - 1) / chunkSize;
+    // Expansión (o shift left/top): los índices de chunk cambian, rebuild completo
+    if (resized) chunks.assign(chunksX * chunksY, Chunk{});
+
+    // Dirty = firma distinta; afectados = dirty + vecinos (comparten entradas de borde)
+    std::vector<uint8_t> affected(chunks.size(), resized ? 1 : 0);
+    for (int c = 0; c < (int)chunks.size(); ++c) {
+        uint64_t sig = computeSignature(c);
+        if (!resized && sig == chunks[c].signature) continue;
+        chunks[c].signature = sig;
+        affected[c] = 1;
+        int cx = c % chunksX, cy = c / chunksX;
+        for (int s = 0; s < 4; ++s) {
+            int nx = cx + sideDx[s], ny = cy + sideDy[s];
+            if (nx >= 0 && nx < chunksX && ny >= 0 && ny < chunksY) affected[ny * chunksX + nx] = 1;
+        }
+    }
+
+    lastRebuilt = 0;
+    for (int c = 0; c < (int)chunks.size(); ++c) {
+        if (!affected[c]) continue;
+        rebuildChunk(c);
+        ++lastRebuilt;
+    }
+    if (lastRebuilt == 0) return;
+
+    nodeBase.resize(chunks.size());
+    nodeCount = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        nodeBase[c] = (int)nodeCount;
+        nodeCount += chunks[c].nodes.size();
+    }
+    routeCache.clear();
+}
+
+void ChunkPathfinder::rebuildChunk(int chunk) {
+    Chunk& ch = chunks[chunk];
+    ch.nodes.clear();
+    ch.pathCache.clear();
+
+    int x0, y0, x1, y1;
+    chunkBounds(chunk, x0, y0, x1, y1);
+
+    // Entradas: runs maximales de celdas caminables a ambos lados del borde, un nodo al medio.
+    // El vecino recorre el mismo borde en el mismo orden -> run k de aquí = run k de allá
+    for (int s = 0; s < 4; ++s) {
+        ch.sideStart[s] = (int)ch.nodes.size();
+        bool horizontal = (s == 0 || s == 2);
+        int fixed = (s == 0) ? y0 : (s == 1) ? x1 : (s == 2) ? y1 : x0;
+        int outside = fixed + (horizontal ? sideDy[s] : sideDx[s]);
+        if (outside < 0 || outside >= (horizontal ? height : width)) continue;  // Borde del mapa
+
+        int from = horizontal ? x0 : y0;
+        int to = horizontal ? x1 : y1;
+        int16_t run = 0;
+        int runStart = -1;
+        for (int i = from; i <= to + 1; ++i) {
+            bool open = false;
+            if (i <= to) {
+                open = horizontal ? (!isSolid(i, fixed) && !isSolid(i, outside))
+                                  : (!isSolid(fixed, i) && !isSolid(outside, i));
+            }
+            if (open && runStart < 0) runStart = i;
+            if (!open && runStart >= 0) {
+                int mid = (runStart + i - 1) / 2;
+                int tile = horizontal ? fixed * width + mid : mid * width + fixed;
+                ch.nodes.push_back({tile, (int8_t)s, run++});
+                runStart = -1;
+            }
+        }
+    }
+    ch.sideStart[4] = (int)ch.nodes.size();
+
+    // Costos intra-chunk: un BFS local por nodo
+    const int n = (int)ch.nodes.size();
+    ch.cost.assign(n * n, -1);
+    for (int i = 0; i < n; ++i) {
+        bfsChunk(chunk, ch.nodes[i].tile, localDist, localParent);
+        for (int j = 0; j < n; ++j) {
+            ch.cost[i * n + j] = localDist[localIndex(chunk, ch.nodes[j].tile)];
+        }
+    }
+}
+
+void ChunkPathfinder::bfsChunk(int chunk, int fromTile, std::vector<int>& dist, std::vector<int>& parent) const {
+    int x0, y0, x1, y1;
+    chunkBounds(chunk, x0, y0, x1, y1);
+    dist.assign(chunkSize * chunkSize, -1);
+    parent.assign(chunkSize * chunkSize, -1);
+
+    int fx = fromTile % width, fy = fromTile / width;
+    if (isSolid(fx, fy)) return;
+
+    // Cola sobre índices locales (misma capacidad que el chunk)
+    static thread_local std::vector<int> queue;
+    queue.clear();
+    int start = (fy - y0) * chunkSize + (fx - x0);
+    dist[start] = 0;
+    queue.push_back(start);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int l = queue[head];
+        int lx = l % chunkSize, ly = l / chunkSize;
+        for (int s = 0; s < 4; ++s) {
+            int nx = lx + sideDx[s], ny = ly + sideDy[s];
+            if (nx < 0 || ny < 0 || x0 + nx > x1 || y0 + ny > y1) continue;
+            if (isSolid(x0 + nx, y0 + ny)) continue;
+            int nl = ny * chunkSize + nx;
+            if (dist[nl] != -1) continue;
+            dist[nl] = dist[l] + 1;
+            parent[nl] = l;
+            queue.push_back(nl);
+        }
+    }
+}
+
+// towardRoot=false: tiles de la raíz del BFS hasta toTile. true: de fromTile hasta la raíz
+void ChunkPathfinder::appendLocal(int chunk, const std::vector<int>& parent, int fromTile, int toTile, bool towardRoot, std::vector<int>& tiles) const {
+    int x0, y0, x1, y1;
+    chunkBounds(chunk, x0, y0, x1, y1);
+    auto toGlobal = [&](int l) { return (y0 + l / chunkSize) * width + (x0 + l % chunkSize); };
+
+    size_t begin = tiles.size();
+    int l = localIndex(chunk, towardRoot ? fromTile : toTile);
+    while (l != -1) {
+        int t = toGlobal(l);
+        if (tiles.size() == begin || tiles.back() != t) tiles.push_back(t);
+        l = parent[l];
+    }
+    if (!towardRoot) std::reverse(tiles.begin() + begin, tiles.end());
+}
+
+const std::vector<int>& ChunkPathfinder::intraPath(int chunk, int a, int b) {
+    Chunk& ch = chunks[chunk];
+    uint32_t key = ((uint32_t)a << 16) | (uint32_t)b;
+    auto it = ch.pathCache.find(key);
+    if (it != ch.pathCache.end()) return it->second;
+
+    std::vector<int> tiles;
+    bfsChunk(chunk, ch.nodes[a].tile, localDist, localParent);
+    appendLocal(chunk, localParent, ch.nodes[a].tile, ch.nodes[b].tile, false, tiles);
+    return ch.pathCache.emplace(key, std::move(tiles)).first->second;
+}
+
+bool ChunkPathfinder::searchAbstract(int startTile, int goalTile, std::vector<int>& route) {
+    const int startChunk = chunkOf(startTile);
+    const int goalChunk = chunkOf(goalTile);
+    const int goalId = (int)nodeCount;  // Nodo virtual del goal
+
+    // Conexión start/goal con los nodos de su chunk (BFS local, reusado por el refinamiento)
+    bfsChunk(startChunk, startTile, startDist, startParent);
+    bfsChunk(goalChunk, goalTile, goalDist, goalParent);
+
+    // Cache por (start chunk, goal chunk): válida si start y goal alcanzan sus extremos
+    uint64_t key = ((uint64_t)startChunk << 32) | (uint32_t)goalChunk;
+    auto cached = routeCache.find(key);
+    if (cached != routeCache.end() && !cached->second.empty()) {
+        int first = cached->second.front() - nodeBase[startChunk];
+        int last = cached->second.back() - nodeBase[goalChunk];
+        if (startDist[localIndex(startChunk, chunks[startChunk].nodes[first].tile)] >= 0 &&
+            goalDist[localIndex(goalChunk, chunks[goalChunk].nodes[last].tile)] >= 0) {
+            route = cached->second;
+            ++cacheHits;
+            return true;
+        }
+    }
+
+    int gx = goalTile % width, gy = goalTile / width;
+    auto heuristic = [&](int tile) { return std::abs(tile % width - gx) + std::abs(tile / width - gy); };
+
+    gScore.resize(nodeCount + 1);
+    cameFrom.resize(nodeCount + 1);
+    visitStamp.resize(nodeCount + 1, 0);
+    if (++stamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        stamp = 1;
+    }
+
+    auto& open = openHeap;  // (-f, id) como max-heap
+    open.clear();
+    auto relax = [&](int id, int g, int from, int tile) {
+        if (visitStamp[id] == stamp && gScore[id] <= g) return;
+        visitStamp[id] = stamp;
+        gScore[id] = g;
+        cameFrom[id] = from;
+        int h = (id == goalId) ? 0 : heuristic(tile);
+        open.push_back({-(g + h), id});
+        std::push_heap(open.begin(), open.end());
+    };
+
+    const Chunk& sc = chunks[startChunk];
+    for (int i = 0; i < (int)sc.nodes.size(); ++i) {
+        int d = startDist[localIndex(startChunk, sc.nodes[i].tile)];
+        if (d >= 0) relax(nodeBase[startChunk] + i, d, -1, sc.nodes[i].tile);
+    }
+
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end());
+        auto [negF, u] = open.back();
+        open.pop_back();
+        if (u == goalId) { found = true; break; }
+
+        int c = ownerChunk(u);
+        int tile = chunks[c].nodes[u - nodeBase[c]].tile;
+        int h = heuristic(tile);
+        if (-negF > gScore[u] + h) continue;  // Entrada vieja del heap
+
+        const Chunk& ch = chunks[c];
+        const int n = (int)ch.nodes.size();
+        const int i = u - nodeBase[c];
+        const int g = gScore[u];
+
+        // Intra-chunk
+        for (int j = 0; j < n; ++j) {
+            int cost = ch.cost[i * n + j];
+            if (j != i && cost >= 0) relax(nodeBase[c] + j, g + cost, u, ch.nodes[j].tile);
+        }
+        // Inter-chunk: la entrada gemela del vecino, a 1 paso
+        const Node& node = ch.nodes[i];
+        int nc = c + sideDx[node.side] + sideDy[node.side] * chunksX;
+        int opp = (node.side + 2) % 4;
+        int j = chunks[nc].sideStart[opp] + node.run;
+        if (j < chunks[nc].sideStart[opp + 1]) relax(nodeBase[nc] + j, g + 1, u, chunks[nc].nodes[j].tile);
+        // Goal
+        if (c == goalChunk) {
+            int d = goalDist[localIndex(goalChunk, tile)];
+            if (d >= 0) relax(goalId, g + d, u, goalTile);
+        }
+    }
+    if (!found) return false;
+
+    route.clear();
+    for (int id = cameFrom[goalId]; id != -1; id = cameFrom[id]) route.push_back(id);
+    std::reverse(route.begin(), route.end());
+    routeCache[key] = route;
+    return true;
+}
+
+bool ChunkPathfinder::findPath(Vector2 fromWorld, Vector2 toWorld, std::vector<Vector2>& out) {
+    PROFILE_ZONE("ChunkPathfinder::findPath");
+    out.clear();
+    if (!built || nodeBase.empty()) return false;
+
+    int sx = (int)floorf(fromWorld.x / tileWorld), sy = (int)floorf(fromWorld.y / tileWorld);
+    int gx = (int)floorf(toWorld.x / tileWorld), gy = (int)floorf(toWorld.y / tileWorld);
+    if (isSolid(sx, sy) || isSolid(gx, gy)) return false;
+    int startTile = sy * width + sx;
+    int goalTile = gy * width + gx;
+    int startChunk = chunkOf(startTile);
+    int goalChunk = chunkOf(goalTile);
+
+    static thread_local std::vector<int> tiles;
+    tiles.clear();
+
+    // Mismo chunk: BFS local directo si conecta
+    if (startChunk == goalChunk) {
+        bfsChunk(startChunk, startTile, localDist, localParent);
+        if (localDist[localIndex(startChunk, goalTile)] >= 0) {
+            appendLocal(startChunk, localParent, startTile, goalTile, false, tiles);
+            toWaypoints(tiles, out);
+            return true;
+        }
+    }
+
+    static thread_local std::vector<int> route;
+    if (!searchAbstract(startTile, goalTile, route) || route.empty()) return false;
+
+    // Refinamiento: start -> primer nodo, tramos intra (cacheados) / cruces de borde, último nodo -> goal
+    int firstTile = chunks[startChunk].nodes[route.front() - nodeBase[startChunk]].tile;
+    appendLocal(startChunk, startParent, startTile, firstTile, false, tiles);
+    for (size_t k = 0; k + 1 < route.size(); ++k) {
+        int ca = ownerChunk(route[k]), cb = ownerChunk(route[k + 1]);
+        int a = route[k] - nodeBase[ca], b = route[k + 1] - nodeBase[cb];
+        if (ca == cb) {
+            const auto& seg = intraPath(ca, a, b);
+            for (int t : seg) if (tiles.empty() || tiles.back() != t) tiles.push_back(t);
+        } else {
+            tiles.push_back(chunks[cb].nodes[b].tile);  // Cruce de borde: tiles adyacentes
+        }
+    }
+    int lastTile = chunks[goalChunk].nodes[route.back() - nodeBase[goalChunk]].tile;
+    static thread_local std::vector<int> tail;
+    tail.clear();
+    appendLocal(goalChunk, goalParent, lastTile, goalTile, true, tail);
+    for (int t : tail) if (tiles.back() != t) tiles.push_back(t);
+
+    toWaypoints(tiles, out);
+    return true;
+}
+
+void ChunkPathfinder::toWaypoints(const std::vector<int>& tiles, std::vector<Vector2>& out) const {
+    auto center = [&](int t) {
+        return Vector2{(t % width + 0.5f) * tileWorld, (t / width + 0.5f) * tileWorld};
+    };
+    // Solo esquinas: descarta tiles intermedios en línea recta
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (i > 0 && i + 1 < tiles.size()) {
+            int d1 = tiles[i] - tiles[i - 1];
+            int d2 = tiles[i + 1] - tiles[i];
+            if (d1 == d2) continue;
+        }
+        out.push_back(center(tiles[i]));
+    }
+}
+
+bool ChunkPathfinder::nearestWalkable(Vector2 world, int maxRadius, Vector2& out) const {
+    if (!built) return false;
+    int tx = (int)floorf(world.x / tileWorld), ty = (int)floorf(world.y / tileWorld);
+    for (int r = 0; r <= maxRadius; ++r) {
+        for (int y = ty - r; y <= ty + r; ++y) {
+            for (int x = tx - r; x <= tx + r; ++x) {
+                if (std::max(std::abs(x - tx), std::abs(y - ty)) != r) continue;  // Solo el anillo
+                if (isSolid(x, y)) continue;
+                out = {(x + 0.5f) * tileWorld, (y + 0.5f) * tileWorld};
+                return true;
+            }
+        }
+    }
+    return false;
+}
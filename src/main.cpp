@@ -1,8 +1,51 @@
 // src/main.cpp
 #include "Game.h"
+#include "headless.h"
+#include "replay.h"
+#include <cstring>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char** argv) {
+    // --headless: sin ventana/GL; corre --scene NAME por --ticks N y reporta timings y memoria.
+    // --alloc-budget N: exit 1 si algún tick (tras warmup) hace más de N allocations
+    // --record FILE graba input + seed + hash por tick; --replay FILE lo reproduce headless y exit 1 si diverge
+    bool headless = false;
+    HeadlessConfig headlessConfig;
+    float tickRate = 0.0f;
+    int fps = -1;
+    std::string recordPath;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) headless = true;
+        else if (strcmp(argv[i], "--no-wander") == 0) headlessConfig.wander = false;
+        else if (i + 1 >= argc) break;
+        else if (strcmp(argv[i], "--tick-rate") == 0) tickRate = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--fps") == 0) fps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--scene") == 0) headlessConfig.scene = argv[++i];
+        else if (strcmp(argv[i], "--ticks") == 0) headlessConfig.ticks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--alloc-budget") == 0) headlessConfig.allocBudget = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0) headlessConfig.warmupTicks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0) setSessionSeed((uint32_t)strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0) {
+            headlessConfig.replayPath = argv[++i];
+            headless = true;  // Replay siempre sin ventana y a máxima velocidad
+        }
+    }
+
+    if (headless) {
+        if (tickRate > 0.0f) headlessConfig.dt = 1.0f / tickRate;
+        headlessConfig.recordPath = recordPath;
+        HeadlessReport report = runHeadless(headlessConfig);
+        printHeadlessReport(headlessConfig, report);
+        return report.ok ? 0 : 1;
+    }
 
-int main() {
     Game game("Breakout ECS", 800, 600);
+    // --tick-rate N (Hz de simulación) y --fps N (tope de render, 0 = sin límite), independientes
+    if (tickRate > 0.0f) game.setTickRate(tickRate);
+    if (fps >= 0) game.setRenderRate(fps);
+    if (!recordPath.empty()) game.startRecording(recordPath);
     game.setup();
 
     while (game.running()) {
@@ -15,4 +58,4 @@ int main() {
 
     game.clean();
     return 0;
-}
\ No newline at end of file
+}
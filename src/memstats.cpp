@@ -0,0 +1,132 @@
+// src/memstats.cpp
+#include "memstats.h"
+#include "platform.h"
+#include <atomic>
+#include <cstdlib>
+#include <unordered_map>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define MEMSTATS_USABLE_SIZE(p) malloc_usable_size(p)
+#else
+#define MEMSTATS_USABLE_SIZE(p) ((size_t)0)
+#endif
+
+// Contadores: atomics relaxed (globales) + POD thread_local (sin init dinámico, seguro dentro de operator new).
+// Los hooks viven en allochooks.cpp (solo ejecutables): linkear el engine no reemplaza el allocator
+static std::atomic<uint64_t> allocCount{0};
+static std::atomic<uint64_t> freeCount{0};
+static std::atomic<uint64_t> allocBytes{0};
+static std::atomic<int64_t> liveBytes{0};
+static thread_local uint64_t threadAllocs = 0;
+
+static std::atomic<bool> hooksInstalled{false};
+
+void memstatsNoteAlloc(std::size_t requested, void* p) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(requested, std::memory_order_relaxed);
+    liveBytes.fetch_add((int64_t)MEMSTATS_USABLE_SIZE(p), std::memory_order_relaxed);
+    ++threadAllocs;
+}
+
+void memstatsNoteFree(void* p) {
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+    liveBytes.fetch_sub((int64_t)MEMSTATS_USABLE_SIZE(p), std::memory_order_relaxed);
+}
+
+void memstatsSetHooksInstalled() { hooksInstalled.store(true, std::memory_order_relaxed); }
+bool allocHooksInstalled() { return hooksInstalled.load(std::memory_order_relaxed); }
+
+AllocCounters allocCounters() {
+    AllocCounters c;
+    c.allocs = allocCount.load(std::memory_order_relaxed);
+    c.frees = freeCount.load(std::memory_order_relaxed);
+    c.bytesAllocated = allocBytes.load(std::memory_order_relaxed);
+    c.liveBytes = liveBytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+uint64_t threadAllocCount() { return threadAllocs; }
+
+static FrameAllocStats frameStats;
+static uint64_t frameAllocs0 = 0, frameBytes0 = 0;
+static int frameIndex = 0;
+
+void memstatsEndFrame() {
+    AllocCounters c = allocCounters();
+    frameStats.last = c.allocs - frameAllocs0;
+    frameStats.lastBytes = c.bytesAllocated - frameBytes0;
+    frameAllocs0 = c.allocs;
+    frameBytes0 = c.bytesAllocated;
+
+    frameStats.history[frameIndex % FrameAllocStats::kHistory] = (float)frameStats.last;
+    ++frameIndex;
+    const int filled = frameIndex < FrameAllocStats::kHistory ? frameIndex : FrameAllocStats::kHistory;
+    float sum = 0.0f, mx = 0.0f;
+    for (int i = 0; i < filled; ++i) {
+        sum += frameStats.history[i];
+        if (frameStats.history[i] > mx) mx = frameStats.history[i];
+    }
+    frameStats.avg = sum / filled;
+    frameStats.max = (uint64_t)mx;
+}
+
+const FrameAllocStats& frameAllocStats() { return frameStats; }
+
+// Estimación de un unordered_map<Entity,T> de libstdc++: nodo = next + pair (hash no cacheado para size_t)
+template<typename T>
+static size_t mapBytes(const std::unordered_map<Entity, T>& map) {
+    const size_t node = sizeof(void*) + sizeof(std::pair<const Entity, T>);
+    return map.size() * node + map.bucket_count() * sizeof(void*);
+}
+
+template<typename T, typename Extra>
+static void addPool(std::vector<ComponentMemory>& out, const char* name, std::unordered_map<Entity, T>& map, Extra&& extra) {
+    size_t bytes = mapBytes(map);
+    for (auto& [e, comp] : map) bytes += extra(comp);
+    out.push_back({name, map.size(), bytes});
+}
+
+template<typename T>
+static void addPool(std::vector<ComponentMemory>& out, const char* name, std::unordered_map<Entity, T>& map) {
+    out.push_back({name, map.size(), mapBytes(map)});
+}
+
+void collectMemoryReport(ECS& ecs, MemoryReport& out) {
+    out.components.clear();
+    auto& c = out.components;
+    addPool(c, "Position", ecs.getComponentMap<Position>());
+    addPool(c, "Velocity", ecs.getComponentMap<Velocity>());
+    addPool(c, "Size", ecs.getComponentMap<Size>());
+    addPool(c, "Sprite", ecs.getComponentMap<Sprite>());
+    addPool(c, "Animation", ecs.getComponentMap<Animation>(), [](const Animation& anim) {
+        size_t bytes = 0;
+        for (const auto& frames : anim.rectStates) bytes += frames.capacity() * sizeof(Rectangle);
+        for (const auto& frames : anim.texStates) bytes += frames.capacity() * sizeof(Texture2D);
+        return bytes;
+    });
+    addPool(c, "MovementPattern", ecs.getComponentMap<MovementPattern>());
+    addPool(c, "PatrolRoute", ecs.getComponentMap<PatrolRoute>(), [](const PatrolRoute& route) {
+        return route.points.isInline() ? 0 : route.points.capacity() * sizeof(Vector2);  // Bloque del arena
+    });
+    addPool(c, "InputControlled", ecs.getComponentMap<InputControlled>());
+    addPool(c, "Health", ecs.getComponentMap<Health>());
+    addPool(c, "Score", ecs.getComponentMap<Score>());
+    addPool(c, "CameraComp", ecs.getComponentMap<CameraComp>());
+    addPool(c, "EnemySpawner", ecs.getComponentMap<EnemySpawner>());
+    addPool(c, "SpawnedBy", ecs.getComponentMap<SpawnedBy>());
+    addPool(c, "PaddleControlled", ecs.getComponentMap<PaddleControlled>());
+    addPool(c, "TileMap", ecs.getComponentMap<TileMap>());  // Sin tiles: van aparte
+
+    out.componentBytes = 0;
+    for (const ComponentMemory& m : c) out.componentBytes += m.bytes;
+
+    out.tileCount = 0;
+    out.tileMapBytes = 0;
+    for (auto& [e, tilemap] : ecs.getComponentMap<TileMap>()) {
+        out.tileCount += tilemap.tiles.size();
+        out.tileMapBytes += tilemap.tiles.capacity() * sizeof(Tile);
+    }
+
+    out.textureCount = textureStats(out.textureBytes);
+    out.allocs = allocCounters();
+}
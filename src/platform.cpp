@@ -0,0 +1,166 @@
+// src/platform.cpp
+#include "platform.h"
+#include <unordered_map>
+#include <ctime>
+#include <utility>
+
+static bool headlessMode = false;
+
+// Texturas vivas por id (id 0 = handles headless, que nunca se descargan)
+static std::unordered_map<unsigned int, size_t> liveTextures;
+static int headlessTextures = 0;
+static size_t headlessTextureBytes = 0;
+
+// Estado del input stub (mismo rango de keycodes que raylib)
+static const int kMaxKeys = 512;
+static bool stubKeys[kMaxKeys] = {};
+static bool stubPrevKeys[kMaxKeys] = {};
+static bool stubInput = false;
+
+// RNG: cada thread arranca con seed de time() hasta que alguien llame setRandomSeed
+static thread_local RandomState rngState;
+static thread_local bool rngSeeded = false;
+
+void setHeadless(bool headless) { headlessMode = headless; }
+bool isHeadless() { return headlessMode; }
+
+Texture2D loadTexture(const char* path) {
+    if (!headlessMode) {
+        Texture2D texture = LoadTexture(path);
+        if (texture.id != 0) liveTextures[texture.id] = GetPixelDataSize(texture.width, texture.height, texture.format);
+        return texture;
+    }
+
+    // Decode en CPU solo para leer dimensiones/formato; no se sube nada a GPU
+    Texture2D texture = {};
+    Image image = LoadImage(path);
+    if (image.data) {
+        texture.width = image.width;
+        texture.height = image.height;
+        texture.mipmaps = 1;
+        texture.format = image.format;
+        UnloadImage(image);
+        ++headlessTextures;
+        headlessTextureBytes += GetPixelDataSize(texture.width, texture.height, texture.format);
+    }
+    return texture;
+}
+
+void unloadTexture(Texture2D texture) {
+    if (texture.id == 0) {
+        if (headlessMode && texture.width > 0 && headlessTextures > 0) {
+            --headlessTextures;
+            headlessTextureBytes -= GetPixelDataSize(texture.width, texture.height, texture.format);
+        }
+        return;
+    }
+    liveTextures.erase(texture.id);
+    UnloadTexture(texture);
+}
+
+Texture2D createTexture(int width, int height, Color color) {
+    Texture2D texture = {};
+    if (width <= 0 || height <= 0) return texture;
+    if (!headlessMode) {
+        Image image = GenImageColor(width, height, color);
+        texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        if (texture.id != 0) liveTextures[texture.id] = GetPixelDataSize(width, height, texture.format);
+        return texture;
+    }
+
+    texture.width = width;
+    texture.height = height;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    ++headlessTextures;
+    headlessTextureBytes += GetPixelDataSize(width, height, texture.format);
+    return texture;
+}
+
+void updateTexture(Texture2D texture, const void* pixels) {
+    if (texture.id != 0) UpdateTexture(texture, pixels);
+}
+
+void updateTextureRect(Texture2D texture, Rectangle rect, const void* pixels) {
+    if (texture.id != 0) UpdateTextureRec(texture, rect, pixels);
+}
+
+Image readTexture(Texture2D texture) {
+    if (headlessMode || texture.id == 0) return Image{};
+    Image image = LoadImageFromTexture(texture);
+    if (image.data) ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    return image;
+}
+
+int textureStats(size_t& bytes) {
+    bytes = headlessTextureBytes;
+    for (auto& [id, size] : liveTextures) bytes += size;
+    return (int)liveTextures.size() + headlessTextures;
+}
+
+bool inputKeyDown(int key) {
+    if (!headlessMode && !stubInput) return IsKeyDown(key);
+    return key >= 0 && key < kMaxKeys && stubKeys[key];
+}
+
+bool inputKeyPressed(int key) {
+    if (!headlessMode && !stubInput) return IsKeyPressed(key);
+    return key >= 0 && key < kMaxKeys && stubKeys[key] && !stubPrevKeys[key];
+}
+
+void setStubKey(int key, bool down) {
+    if (key >= 0 && key < kMaxKeys) stubKeys[key] = down;
+}
+
+bool stubKeyDown(int key) {
+    return key >= 0 && key < kMaxKeys && stubKeys[key];
+}
+
+void setStubInput(bool stub) { stubInput = stub; }
+
+void advanceStubInput() {
+    for (int i = 0; i < kMaxKeys; ++i) stubPrevKeys[i] = stubKeys[i];
+}
+
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+void setRandomSeed(unsigned int seed) {
+    uint64_t x = seed;
+    uint64_t a = splitmix64(x), b = splitmix64(x);
+    rngState = {{(uint32_t)a, (uint32_t)(a >> 32), (uint32_t)b, (uint32_t)(b >> 32)}};
+    rngSeeded = true;
+}
+
+int randomValue(int min, int max) {
+    if (!rngSeeded) setRandomSeed((unsigned int)time(nullptr));
+    if (min > max) std::swap(min, max);
+    uint32_t* s = rngState.s;
+    const uint32_t result = rotl(s[1] * 5, 7) * 9;
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    const uint32_t range = (uint32_t)((int64_t)max - min) + 1;
+    return range == 0 ? (int)result : (int)(min + (int64_t)(result % range));
+}
+
+RandomState getRandomState() {
+    if (!rngSeeded) setRandomSeed((unsigned int)time(nullptr));
+    return rngState;
+}
+
+void setRandomState(const RandomState& state) {
+    rngState = state;
+    rngSeeded = true;
+}
@@ -0,0 +1,37 @@
+// src/pool.cpp
+#include "pool.h"
+#include <utility>
+
+Entity EnemyPool::acquire(ECS& ecs) {
+    if (parked.empty()) return (Entity)-1;
+
+    ParkedEnemy slot = std::move(parked.back());
+    parked.pop_back();
+    std::apply([&](auto&... nodes) { (ecs.restoreComponent<typename std::decay_t<decltype(nodes)>::mapped_type>(std::move(nodes)), ...); }, slot.nodes);
+
+    ++live;
+    ++recycled;
+    return slot.id;
+}
+
+void EnemyPool::release(ECS& ecs, Entity e) {
+    ParkedEnemy slot;
+    slot.id = e;
+    std::apply([&](auto&... nodes) { ((nodes = ecs.extractComponent<typename std::decay_t<decltype(nodes)>::mapped_type>(e)), ...); }, slot.nodes);
+    parked.push_back(std::move(slot));
+    auto route = ecs.extractComponent<PatrolRoute>(e);
+    if (!route.empty()) spareRoutes.push_back(std::move(route));
+    --live;
+}
+
+PatrolRoute& EnemyPool::attachRoute(ECS& ecs, Entity e) {
+    if (auto* route = ecs.getComponent<PatrolRoute>(e)) return *route;
+    if (!spareRoutes.empty()) {
+        auto node = std::move(spareRoutes.back());
+        spareRoutes.pop_back();
+        node.key() = e;
+        if (auto* route = ecs.restoreComponent<PatrolRoute>(std::move(node))) return *route;
+    }
+    ecs.addComponent(e, PatrolRoute{});
+    return *ecs.getComponent<PatrolRoute>(e);
+}
@@ -0,0 +1,135 @@
+// src/prefab.cpp
+#include "prefab.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+Prefab& PrefabLibrary::add(const std::string& name) {
+    auto it = prefabs.find(name);
+    if (it != prefabs.end()) return it->second;
+    return prefabs.emplace(name, Prefab(name)).first->second;
+}
+
+Prefab* PrefabLibrary::find(const std::string& name) {
+    auto it = prefabs.find(name);
+    return it != prefabs.end() ? &it->second : nullptr;
+}
+
+// Component existente en el prefab, o default nuevo
+template<typename T>
+static T& ensure(Prefab& prefab) {
+    if (!prefab.get<T>()) prefab.with(T{});
+    return *prefab.get<T>();
+}
+
+static bool parseBool(const std::string& v) {
+    return v == "true" || v == "1";
+}
+
+static bool applyField(Prefab& prefab, const std::string& component, const std::string& field, std::istringstream& in) {
+    std::string word;
+    if (component == "Position") { auto& c = ensure<Position>(prefab); in >> c.pos.x >> c.pos.y; return true; }
+    if (component == "Velocity") { auto& c = ensure<Velocity>(prefab); in >> c.vel.x >> c.vel.y; return true; }
+    if (component == "Size") { auto& c = ensure<Size>(prefab); in >> c.w >> c.h; return true; }
+    if (component == "Health") { auto& c = ensure<Health>(prefab); in >> c.value; return true; }
+    if (component == "Score") { auto& c = ensure<Score>(prefab); in >> c.value; return true; }
+    if (component == "InputControlled") { ensure<InputControlled>(prefab); return true; }
+
+    if (component == "Sprite") {
+        auto& c = ensure<Sprite>(prefab);
+        if (field.empty()) return true;
+        if (field == "tint") { int r, g, b, a = 255; in >> r >> g >> b; if (!(in >> a)) a = 255; c.tint = {(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a}; return true; }
+        if (field == "scale") { in >> c.scale.x >> c.scale.y; return true; }
+        if (field == "isSheet") { in >> word; c.isSheet = parseBool(word); return true; }
+        if (field == "frameRec") { in >> c.frameRec.x >> c.frameRec.y >> c.frameRec.width >> c.frameRec.height; return true; }
+        return false;
+    }
+
+    if (component == "Animation") {
+        auto& c = ensure<Animation>(prefab);
+        if (field.empty()) return true;
+        if (field == "frameTime") { in >> c.frameTime; return true; }
+        if (field == "mode") { in >> word; c.mode = (word == "Separate") ? AnimationMode::Separate : AnimationMode::Sheet; return true; }
+        if (field == "state") { in >> word; return parseAnimState(word, c.currentState); }
+        return false;
+    }
+
+    if (component == "MovementPattern") {
+        auto& c = ensure<MovementPattern>(prefab);
+        if (field.empty()) return true;
+        if (field == "type") {
+            // Solo si cambia: los params del tipo vuelven a sus defaults (los campos del tipo van después de type)
+            in >> word;
+            if (word == "Tracking") { if (c.type != MovementType::Tracking) c.setTracking(); }
+            else if (word == "Circular") { if (c.type != MovementType::Circular) c.setCircular(); }
+            else if (word == "Patrol") { if (c.type != MovementType::Patrol) c.setPatrol(); }
+            else c.setNone();
+            return true;
+        }
+        if (field == "speed") { in >> c.speed; return true; }
+        if (field == "aroundTarget") { in >> word; c.aroundTarget = parseBool(word); return true; }
+        // Campos por tipo: desconocidos si el type del prefab es otro
+        if (c.type == MovementType::Tracking) {
+            if (field == "pursuitDistance") { in >> c.tracking.pursuitDistance; return true; }
+            if (field == "lerpFactor") { in >> c.tracking.lerpFactor; return true; }
+        } else if (c.type == MovementType::Circular) {
+            if (field == "center") { in >> c.circular.center.x >> c.circular.center.y; return true; }
+            if (field == "radius") { in >> c.circular.radius; return true; }
+            if (field == "angularSpeed") { in >> c.circular.angularSpeed; return true; }
+        } else if (c.type == MovementType::Patrol) {
+            if (field == "arrivalThreshold") { in >> c.patrol.arrivalThreshold; return true; }
+        }
+        return false;
+    }
+
+    if (component == "PatrolRoute") {  // Los puntos los arma el código por instancia (syncPatrolRoute)
+        auto& c = ensure<PatrolRoute>(prefab);
+        if (field.empty()) return true;
+        if (field == "loop") { in >> word; c.loop = parseBool(word); return true; }
+        return false;
+    }
+    return false;
+}
+
+bool PrefabLibrary::loadFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Prefabs: no se pudo abrir " << path << " (se usan defaults de código)" << std::endl;
+        return false;
+    }
+
+    Prefab* current = nullptr;
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        ++lineNum;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+
+        if (line.front() == '[' && line.back() == ']') {
+            current = &add(line.substr(1, line.size() - 2));
+            continue;
+        }
+        if (!current) {
+            std::cerr << path << ":" << lineNum << ": línea fuera de sección [prefab]" << std::endl;
+            continue;
+        }
+
+        // "Component.campo = valores" o "Component = valores"
+        auto eq = line.find('=');
+        std::string key = line.substr(0, eq);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        std::istringstream values(eq == std::string::npos ? "" : line.substr(eq + 1));
+        auto dot = key.find('.');
+        std::string component = key.substr(0, dot);
+        std::string field = (dot == std::string::npos) ? "" : key.substr(dot + 1);
+
+        if (!applyField(*current, component, field, values)) {
+            std::cerr << path << ":" << lineNum << ": campo desconocido '" << key << "'" << std::endl;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,191 @@
+// src/profiler.cpp
+#include "profiler.h"
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_HAS_TSC 1
+#endif
+
+static int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::now() {
+#ifdef PROFILER_HAS_TSC
+    return __rdtsc();
+#else
+    return (uint64_t)steadyNs();
+#endif
+}
+
+Profiler::Profiler() {
+    frameTimes.reserve(kFrameHistory);
+#ifdef PROFILER_HAS_TSC
+    // Estimación inicial con ~2 ms de espera; endFrame la refina con una base cada vez más larga
+    calibTicks0 = now();
+    calibNs0 = steadyNs();
+    while (steadyNs() - calibNs0 < 2000000) {}
+    calibrate();
+#endif
+    lastFrameEnd = now();
+}
+
+void Profiler::calibrate() {
+#ifdef PROFILER_HAS_TSC
+    uint64_t ticks = now() - calibTicks0;
+    int64_t ns = steadyNs() - calibNs0;
+    if (ticks > 0 && ns > 0) nsPerTick = (double)ns / (double)ticks;
+#endif
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    // Al salir el thread, el buffer queda libre (sus eventos pendientes se recogen igual en endFrame)
+    struct Lease {
+        ThreadBuffer* buffer = nullptr;
+        ~Lease() {
+            if (buffer) {
+                std::lock_guard<std::mutex> lock(buffer->mutex);
+                buffer->inUse = false;
+            }
+        }
+    };
+    thread_local Lease lease;
+    if (lease.buffer) return *lease.buffer;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& buffer : buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (!buffer->inUse) {
+            buffer->inUse = true;
+            lease.buffer = buffer.get();
+            return *lease.buffer;
+        }
+    }
+    buffers.push_back(std::make_unique<ThreadBuffer>());
+    lease.buffer = buffers.back().get();
+    lease.buffer->index = (uint16_t)(buffers.size() - 1);
+    lease.buffer->events.reserve(1024);
+    return *lease.buffer;
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end, uint16_t depth, uint32_t allocs) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({name, start, end, depth, buffer.index, allocs});
+}
+
+int Profiler::getThreadCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return (int)buffers.size();
+}
+
+ProfileZoneStats& Profiler::zoneFor(const char* name) {
+    // Mismo literal suele compartir puntero; strcmp cubre literales duplicados entre TUs
+    for (auto& zone : zones) {
+        if (zone.name == name || strcmp(zone.name, name) == 0) return zone;
+    }
+    zones.emplace_back();
+    zones.back().name = name;
+    return zones.back();
+}
+
+void Profiler::endFrame() {
+    uint64_t frameEnd = now();
+    calibrate();
+
+    // Junta los buffers de todos los threads (swap: sin copiar ni liberar capacidad)
+    lastFrame.clear();
+    {
+        std::lock_guard<std::mutex> registryLock(registryMutex);
+        for (auto& buffer : buffers) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            scratch.swap(buffer->events);
+            buffer->events.clear();
+            lastFrame.insert(lastFrame.end(), scratch.begin(), scratch.end());
+            scratch.clear();
+        }
+    }
+    std::sort(lastFrame.begin(), lastFrame.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+        return a.thread != b.thread ? a.thread < b.thread : a.start < b.start;
+    });
+    lastFrameStart = lastFrameEnd;
+    lastFrameEnd = frameEnd;
+
+    // Stats rodantes: suma por zona este frame -> history[frameIndex]
+    const int slot = frameIndex % ProfileZoneStats::kHistory;
+    for (auto& zone : zones) {
+        zone.history[slot] = 0.0f;
+        zone.allocHistory[slot] = 0.0f;
+        zone.calls = 0;
+        zone.allocs = 0;
+    }
+    for (const ProfileEvent& ev : lastFrame) {
+        ProfileZoneStats& zone = zoneFor(ev.name);
+        zone.history[slot] += (float)ticksToMs(ev.end - ev.start);
+        zone.allocHistory[slot] += (float)ev.allocs;
+        zone.allocs += (int)ev.allocs;
+        ++zone.calls;
+    }
+    ++frameIndex;
+
+    const int filled = std::min(frameIndex, ProfileZoneStats::kHistory);
+    float sorted[ProfileZoneStats::kHistory];
+    for (auto& zone : zones) {
+        float sum = 0.0f, allocSum = 0.0f;
+        for (int i = 0; i < filled; ++i) {
+            sorted[i] = zone.history[i];
+            sum += zone.history[i];
+            allocSum += zone.allocHistory[i];
+        }
+        zone.avgAllocs = allocSum / filled;
+        std::sort(sorted, sorted + filled);
+        zone.minMs = sorted[0];
+        zone.avgMs = sum / filled;
+        zone.p99Ms = sorted[std::min(filled - 1, (int)(filled * 0.99f))];
+        zone.lastMs = zone.history[slot];
+    }
+
+    if (frameTimes.size() == kFrameHistory) frameTimes.erase(frameTimes.begin());
+    frameTimes.push_back((float)ticksToMs(lastFrameEnd - lastFrameStart));
+
+    if (captureFramesLeft > 0) {
+        captured.insert(captured.end(), lastFrame.begin(), lastFrame.end());
+        --captureFramesLeft;
+    }
+}
+
+void Profiler::startCapture(int frames) {
+    captured.clear();
+    captureFramesLeft = frames;
+    captureOrigin = now();
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    FILE* f = fopen(path.c_str(), "w");
+    if (!f) {
+        std::cerr << "Error: no se pudo escribir " << path << std::endl;
+        return false;
+    }
+    // Formato "complete events" (ph X), tiempos en microsegundos
+    fprintf(f, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < captured.size(); ++i) {
+        const ProfileEvent& ev = captured[i];
+        double ts = ev.start >= captureOrigin ? ticksToMs(ev.start - captureOrigin) * 1000.0 : 0.0;
+        double dur = ticksToMs(ev.end - ev.start) * 1000.0;
+        fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}%s\n",
+                ev.name, ts, dur, (unsigned)ev.thread, i + 1 < captured.size() ? "," : "");
+    }
+    fprintf(f, "],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(f);
+    std::cout << "Chrome trace: " << path << " (" << captured.size() << " events)" << std::endl;
+    return true;
+}
@@ -0,0 +1,277 @@
+// src/renderqueue.cpp
+#include "renderqueue.h"
+#include "profiler.h"
+#include <rlgl.h>
+#include <algorithm>
+#include <cstring>
+
+// --- CommandBuffer ---
+
+RenderCommand& CommandBuffer::push(RenderLayer layer, uint32_t texture, uint32_t depth) {
+    keys.push_back(makeSortKey(layer, texture, depth));
+    return commands.emplace_back();
+}
+
+void CommandBuffer::quad(RenderLayer layer, const Texture2D& texture, Rectangle src, Rectangle dst, Color tint, uint32_t depth) {
+    RenderCommand& cmd = push(layer, texture.id, depth);
+    cmd.type = RenderCommandType::Quad;
+    cmd.color = tint;
+    cmd.texture = texture.id;
+    cmd.texWidth = (uint16_t)texture.width;
+    cmd.texHeight = (uint16_t)texture.height;
+    cmd.quad = {src, dst};
+}
+
+void CommandBuffer::rect(RenderLayer layer, Rectangle dst, Color color, uint32_t depth) {
+    RenderCommand& cmd = push(layer, 0, depth);
+    cmd.type = RenderCommandType::Rect;
+    cmd.color = color;
+    cmd.rect = dst;
+}
+
+void CommandBuffer::text(RenderLayer layer, const char* str, int x, int y, int fontSize, Color color, uint32_t depth) {
+    // Copia: TextFormat devuelve un buffer estático que se pisa antes del replay
+    const size_t len = std::strlen(str);
+    const uint32_t offset = (uint32_t)textArena.size();
+    textArena.insert(textArena.end(), str, str + len + 1);
+    RenderCommand& cmd = push(layer, 0, depth);
+    cmd.type = RenderCommandType::Text;
+    cmd.color = color;
+    cmd.text = {x, y, fontSize, offset};
+}
+
+void CommandBuffer::lines(RenderLayer layer, const Vector2* vertices, uint32_t count, float lineWidth, Color color, uint32_t depth) {
+    if (count < 2) return;
+    RenderCommand& cmd = push(layer, 0, depth);
+    cmd.type = RenderCommandType::Lines;
+    cmd.color = color;
+    cmd.geometry = {vertices, count, lineWidth};
+}
+
+void CommandBuffer::triangles(RenderLayer layer, const Vector2* vertices, uint32_t count, Color color, uint32_t depth) {
+    if (count < 3) return;
+    RenderCommand& cmd = push(layer, 0, depth);
+    cmd.type = RenderCommandType::Triangles;
+    cmd.color = color;
+    cmd.geometry = {vertices, count, 1.0f};
+}
+
+void CommandBuffer::clear() {
+    keys.clear();
+    commands.clear();
+    textArena.clear();
+}
+
+// --- RenderQueue: frontend ---
+
+RenderQueue::~RenderQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    workCv.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void RenderQueue::beginFrame() {
+    for (size_t i = 0; i < usedSegments; ++i) segments[i]->clear();
+    usedSegments = 0;
+    cameraSet = false;
+    stats.parallelRanges = 0;  // Se acumula durante la generación del frame
+}
+
+void RenderQueue::setCamera(const Camera2D& cam) {
+    camera = cam;
+    cameraSet = true;
+}
+
+size_t RenderQueue::addSegment() {
+    if (usedSegments == segments.size()) segments.push_back(std::make_unique<CommandBuffer>());
+    return usedSegments++;
+}
+
+size_t RenderQueue::mainSegment() {
+    return usedSegments > 0 ? usedSegments - 1 : addSegment();
+}
+
+void RenderQueue::startWorkers() {
+    if (!workers.empty()) return;
+    unsigned int count = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;  // Como AssetManager
+    for (unsigned int i = 0; i < count; ++i) workers.emplace_back(&RenderQueue::workerLoop, this);
+}
+
+void RenderQueue::runRange(size_t range) {
+    const size_t begin = taskCount * range / taskRanges;
+    const size_t end = taskCount * (range + 1) / taskRanges;
+    (*task)(*segments[taskBase + range], begin, end);
+}
+
+void RenderQueue::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        workCv.wait(lock, [this] { return quit || nextRange < taskRanges; });
+        if (quit) return;
+        const size_t range = nextRange++;
+        lock.unlock();
+        {
+            PROFILE_ZONE("RenderQueue::range");
+            runRange(range);
+        }
+        lock.lock();
+        if (--pendingRanges == 0) doneCv.notify_all();
+    }
+}
+
+void RenderQueue::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+    if (count == 0) return;
+    startWorkers();
+    const size_t maxRanges = workers.size() + 1;
+    const size_t ranges = std::clamp((count + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1), (size_t)1, maxRanges);
+    stats.parallelRanges += (int)ranges;
+    if (ranges == 1) {  // No vale despertar workers
+        fn(main(), 0, count);
+        return;
+    }
+
+    // Segmentos en orden de rango: el merge los concatena igual que un recorrido serial
+    const size_t base = usedSegments;
+    for (size_t i = 0; i < ranges; ++i) addSegment();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &fn;
+        taskCount = count;
+        taskBase = base;
+        taskRanges = ranges;
+        nextRange = 0;
+        pendingRanges = ranges;
+    }
+    workCv.notify_all();
+
+    // El main thread también toma rangos
+    std::unique_lock<std::mutex> lock(mutex);
+    while (nextRange < taskRanges) {
+        const size_t range = nextRange++;
+        lock.unlock();
+        runRange(range);
+        lock.lock();
+        --pendingRanges;
+    }
+    doneCv.wait(lock, [this] { return pendingRanges == 0; });
+    task = nullptr;
+    taskRanges = nextRange = 0;
+    lock.unlock();
+
+    addSegment();  // Los submits de main() que siguen van después de estos rangos
+}
+
+// --- RenderQueue: sort + backend ---
+
+// LSD radix de 8 bits sobre la key de 64: estable, 8 pasadas como máximo. Los bytes constantes en todo el
+// frame (layer, bits altos de textura, depth de los layers sin y-sort) se saltan con el histograma
+void RenderQueue::sortEntries() {
+    const size_t n = entries.size();
+    stats.sortPasses = 0;
+    if (n < 2) return;
+
+    uint32_t counts[8][256] = {};
+    for (const SortEntry& entry : entries) {
+        for (int pass = 0; pass < 8; ++pass) counts[pass][(entry.key >> (pass * 8)) & 0xFF]++;
+    }
+
+    scratch.resize(n);
+    SortEntry* from = entries.data();
+    SortEntry* to = scratch.data();
+    for (int pass = 0; pass < 8; ++pass) {
+        uint32_t* count = counts[pass];
+        if (count[(from[0].key >> (pass * 8)) & 0xFF] == n) continue;  // Un solo bucket: ya está ordenado
+        uint32_t offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            uint32_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) to[count[(from[i].key >> (pass * 8)) & 0xFF]++] = from[i];
+        std::swap(from, to);
+        stats.sortPasses++;
+    }
+    if (from != entries.data()) entries.swap(scratch);
+}
+
+void RenderQueue::sort() {
+    PROFILE_ZONE("RenderQueue::sort");
+    entries.clear();
+    stats.segments = 0;
+    for (size_t s = 0; s < usedSegments; ++s) {
+        const CommandBuffer& buffer = *segments[s];
+        if (buffer.keys.empty()) continue;
+        stats.segments++;
+        for (size_t i = 0; i < buffer.keys.size(); ++i) entries.push_back({buffer.keys[i], (uint32_t)s, (uint32_t)i});
+    }
+    stats.commands = (int)entries.size();
+    sortEntries();
+}
+
+void RenderQueue::flush() {
+    PROFILE_ZONE("RenderQueue::flush");
+    sort();
+    replay();
+}
+
+void RenderQueue::replay() {
+    PROFILE_ZONE("RenderQueue::replay");
+    stats.textureSwitches = 0;
+    bool inCamera = false;
+    uint32_t lastTexture = 0;
+    for (const SortEntry& entry : entries) {
+        const bool world = (entry.key >> 56) < (uint64_t)RenderLayer::Hud;
+        if (world && cameraSet && !inCamera) {
+            BeginMode2D(camera);
+            inCamera = true;
+        } else if (!world && inCamera) {
+            EndMode2D();
+            inCamera = false;
+        }
+
+        const CommandBuffer& buffer = *segments[entry.segment];
+        const RenderCommand& cmd = buffer.commands[entry.index];
+        switch (cmd.type) {
+            case RenderCommandType::Quad: {
+                if (cmd.texture != lastTexture) {
+                    lastTexture = cmd.texture;
+                    stats.textureSwitches++;
+                }
+                Texture2D texture = {cmd.texture, cmd.texWidth, cmd.texHeight, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+                DrawTexturePro(texture, cmd.quad.src, cmd.quad.dst, {0, 0}, 0.0f, cmd.color);
+                break;
+            }
+            case RenderCommandType::Rect:
+                DrawRectangleRec(cmd.rect, cmd.color);
+                break;
+            case RenderCommandType::Text:
+                DrawText(buffer.textArena.data() + cmd.text.offset, cmd.text.x, cmd.text.y, cmd.text.fontSize, cmd.color);
+                break;
+            case RenderCommandType::Lines: {
+                const GeometryCommand& geo = cmd.geometry;
+                rlSetLineWidth(geo.lineWidth);
+                rlBegin(RL_LINES);
+                rlColor4ub(cmd.color.r, cmd.color.g, cmd.color.b, cmd.color.a);
+                rlCheckRenderBatchLimit((int)geo.count);
+                for (uint32_t i = 0; i < geo.count; ++i) rlVertex2f(geo.vertices[i].x, geo.vertices[i].y);
+                rlEnd();
+                rlDrawRenderBatchActive();  // El ancho de línea aplica al flush
+                rlSetLineWidth(1.0f);
+                break;
+            }
+            case RenderCommandType::Triangles: {
+                const GeometryCommand& geo = cmd.geometry;
+                rlBegin(RL_TRIANGLES);
+                rlColor4ub(cmd.color.r, cmd.color.g, cmd.color.b, cmd.color.a);
+                rlCheckRenderBatchLimit((int)geo.count);
+                for (uint32_t i = 0; i < geo.count; ++i) rlVertex2f(geo.vertices[i].x, geo.vertices[i].y);
+                rlEnd();
+                break;
+            }
+        }
+    }
+    if (inCamera) EndMode2D();
+}
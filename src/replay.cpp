@@ -0,0 +1,211 @@
+// src/replay.cpp
+#include "replay.h"
+#include "platform.h"
+#include "breakout.h"
+#include <raylib.h>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <ctime>
+
+// Teclas que lee la simulación (bit i del mask = kReplayKeys[i]); agregar al final para no romper archivos
+static const int kReplayKeys[] = {KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, KEY_SPACE, KEY_S};
+static const int kReplayKeyCount = sizeof(kReplayKeys) / sizeof(kReplayKeys[0]);
+
+static const char kMagic[4] = {'G', 'R', 'P', 'L'};
+static const uint32_t kVersion = 1;
+
+static bool seedSet = false;
+static uint32_t seedValue = 0;
+static bool deterministicMode = false;
+
+void setSessionSeed(uint32_t seed) {
+    seedValue = seed;
+    seedSet = true;
+}
+
+uint32_t sessionSeed() {
+    if (!seedSet) setSessionSeed((uint32_t)time(NULL));
+    return seedValue;
+}
+
+void setDeterministic(bool deterministic) { deterministicMode = deterministic; }
+bool isDeterministic() { return deterministicMode; }
+
+// --- Archivo: header + runs (mask, ticks) + un hash de 32 bits por tick ---
+
+template <typename T>
+static void writePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readPod(std::ifstream& in, T& value) {
+    return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+bool saveReplay(const std::string& path, const Replay& replay) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Replay: cannot write " << path << std::endl;
+        return false;
+    }
+
+    out.write(kMagic, sizeof(kMagic));
+    writePod(out, kVersion);
+    writePod(out, replay.seed);
+    writePod(out, replay.dt);
+    writePod(out, (int32_t)replay.width);
+    writePod(out, (int32_t)replay.height);
+    writePod(out, (uint16_t)replay.scene.size());
+    out.write(replay.scene.data(), replay.scene.size());
+    writePod(out, (uint32_t)replay.input.size());
+
+    // Input casi siempre constante por muchos ticks: runs de (mask, count)
+    std::vector<std::pair<uint16_t, uint16_t>> runs;
+    for (uint16_t mask : replay.input) {
+        if (!runs.empty() && runs.back().first == mask && runs.back().second < UINT16_MAX) runs.back().second++;
+        else runs.push_back({mask, 1});
+    }
+    writePod(out, (uint32_t)runs.size());
+    for (auto& [mask, count] : runs) {
+        writePod(out, mask);
+        writePod(out, count);
+    }
+
+    writePod(out, (uint32_t)replay.hashes.size());
+    out.write(reinterpret_cast<const char*>(replay.hashes.data()), replay.hashes.size() * sizeof(uint32_t));
+
+    if (!out) {
+        std::cerr << "Replay: write failed " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadReplay(const std::string& path, Replay& replay) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Replay: cannot open " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !readPod(in, version) || version != kVersion) {
+        std::cerr << "Replay: " << path << " is not a v" << kVersion << " replay file" << std::endl;
+        return false;
+    }
+
+    int32_t width = 0, height = 0;
+    uint16_t nameLen = 0;
+    uint32_t ticks = 0, runCount = 0, hashCount = 0;
+    bool ok = readPod(in, replay.seed) && readPod(in, replay.dt) && readPod(in, width) && readPod(in, height) && readPod(in, nameLen);
+    if (ok) {
+        replay.scene.resize(nameLen);
+        ok = (bool)in.read(replay.scene.data(), nameLen) && readPod(in, ticks) && readPod(in, runCount);
+    }
+    replay.width = width;
+    replay.height = height;
+
+    replay.input.clear();
+    replay.input.reserve(ticks);
+    for (uint32_t i = 0; ok && i < runCount; ++i) {
+        uint16_t mask = 0, count = 0;
+        ok = readPod(in, mask) && readPod(in, count);
+        replay.input.insert(replay.input.end(), count, mask);
+    }
+
+    ok = ok && readPod(in, hashCount) && replay.input.size() == ticks && hashCount <= ticks;
+    if (ok) {
+        replay.hashes.resize(hashCount);
+        ok = (bool)in.read(reinterpret_cast<char*>(replay.hashes.data()), hashCount * sizeof(uint32_t));
+    }
+
+    if (!ok) {
+        std::cerr << "Replay: truncated or corrupt file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// --- Input ---
+
+uint16_t stubInputMask() {
+    uint16_t mask = 0;
+    for (int i = 0; i < kReplayKeyCount; ++i) {
+        if (stubKeyDown(kReplayKeys[i])) mask |= (uint16_t)(1u << i);
+    }
+    return mask;
+}
+
+void applyInputMask(uint16_t mask) {
+    for (int i = 0; i < kReplayKeyCount; ++i) setStubKey(kReplayKeys[i], (mask >> i) & 1u);
+}
+
+void latchLiveInput() {
+    for (int i = 0; i < kReplayKeyCount; ++i) setStubKey(kReplayKeys[i], IsKeyDown(kReplayKeys[i]));
+}
+
+// --- Hash de estado ---
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static uint64_t bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static uint64_t bits(Vector2 v) { return bits(v.x) | (bits(v.y) << 32); }
+
+// Cada entity aporta mix(salt, id, campos) y se suma: el resultado no depende del orden de los buckets
+template <typename T, typename Fn>
+static uint64_t hashMap(ECS& ecs, uint64_t salt, Fn&& fields) {
+    uint64_t sum = mix64(salt ^ ecs.getComponentMap<T>().size());
+    for (auto& [entity, comp] : ecs.getComponentMap<T>()) {
+        sum += mix64(mix64(salt ^ (uint64_t)entity) ^ fields(comp));
+    }
+    return sum;
+}
+
+uint64_t hashState(ECS& ecs) {
+    uint64_t h = 0;
+    h += hashMap<Position>(ecs, 1, [](const Position& p) { return bits(p.pos); });
+    h += hashMap<Velocity>(ecs, 2, [](const Velocity& v) { return bits(v.vel); });
+    h += hashMap<Health>(ecs, 3, [](const Health& c) { return bits(c.value); });
+    h += hashMap<Score>(ecs, 4, [](const Score& c) { return (uint64_t)(uint32_t)c.value; });
+    h += hashMap<MovementPattern>(ecs, 5, [](const MovementPattern& m) {
+        uint64_t state = 0;  // Solo los params del type activo (el resto del union no está definido)
+        if (m.type == MovementType::Circular) state = bits(m.circular.center) ^ (bits(m.circular.currentAngle) << 16);
+        else if (m.type == MovementType::Patrol) state = bits(m.patrol.waypoint) ^ m.patrol.current;
+        return mix64(state ^ ((uint64_t)m.type << 8));
+    });
+    h += hashMap<EnemySpawner>(ecs, 6, [](const EnemySpawner& s) {
+        return mix64(bits(s.center)) ^ (bits(s.timer) << 16) ^ (uint64_t)s.alive;
+    });
+    h += hashMap<CameraComp>(ecs, 7, [](const CameraComp& c) { return bits(c.cam.target); });
+    h += hashMap<TileMap>(ecs, 8, [](const TileMap& tm) {
+        uint64_t t = mix64(((uint64_t)tm.width << 32) | (uint32_t)tm.height);
+        for (const Tile& tile : tm.tiles) t = t * 31 + (uint64_t)tile.value;
+        return t;
+    });
+    h += hashMap<BlockGrid>(ecs, 9, [](const BlockGrid& g) {
+        uint64_t t = mix64(((uint64_t)g.cols << 32) | (uint32_t)g.aliveCount);
+        for (uint8_t hp : g.hp) t = t * 31 + hp;
+        return t;
+    });
+    h += hashMap<BallSet>(ecs, 10, [](const BallSet& b) {
+        uint64_t t = mix64(b.count());
+        for (size_t i = 0; i < b.count(); ++i)
+            t = mix64(t ^ bits(b.x[i]) ^ (bits(b.y[i]) << 32)) ^ bits(b.vx[i]) ^ (bits(b.vy[i]) << 32);
+        return t;
+    });
+    return h;
+}
@@ -2,6 +2,10 @@
 
 #include "scenes/AdventureScene.h"
 #include "print.h"
+#include "platform.h"
+#include "profiler.h"
+#include "replay.h"
+#include "assets.h"
 #include <raylib.h>
 #include <iostream>
 #include "../perlin.h"
@@ -12,59 +16,73 @@
 
 AdventureScene::AdventureScene(int width, int height) : screen_width(width), screen_height(height) {}
 
-Entity tilemapEnt;
-Entity cameraEnt;
+void AdventureScene::beginLoad() {
+    seed = sessionSeed();  // Variada por run, fija en replays (--seed / archivo)
+
+    // Mago + tiles en un solo atlas: sprites y tilemap se dibujan desde la misma textura (sub-rects)
+    AssetManager& assets = AssetManager::instance();
+    atlas = assets.acquireAtlas("adventure", {"assets/MagoIdel1.png", "assets/MagoIdel2.png", "assets/MagoIdel3.png",
+                                              "assets/MagoIdel4.png", "assets/MagoWalkL1.png", "assets/MagoWalkL2.png",
+                                              "assets/MagoWalkR1.png", "assets/MagoWalkR2.png", "assets/tileset.png",
+                                              "assets/wall.png", "assets/hazard.png", "assets/pickup.png"});
+    atlasTex = assets.get(atlas);
+    atlasRegions = assets.regions(atlas);
+}
 
-void AdventureScene::setup() {
-    SetRandomSeed(time(NULL));  // Para random reproducible/variado cada run (e.g., en spawning)
+void AdventureScene::load(LoadProgress& progress) {
+    setRandomSeed(seed);  // RNG del thread que carga; Game lo pasa al main thread al activar
+    auto frame = [&](const char* path) {
+        auto it = atlasRegions.find(path);
+        return it != atlasRegions.end() ? it->second : Rectangle{0, 0, 0, 0};
+    };
 
-    Texture2D playerIdle1 = LoadTexture("assets/MagoIdel1.png");
-    Texture2D playerIdle2 = LoadTexture("assets/MagoIdel2.png");
-    Texture2D playerIdle3 = LoadTexture("assets/MagoIdel3.png");
-    Texture2D playerIdle4 = LoadTexture("assets/MagoIdel4.png");
-    Texture2D playerLeft1 = LoadTexture("assets/MagoWalkL1.png");
-    Texture2D playerLeft2 = LoadTexture("assets/MagoWalkL2.png");
-    Texture2D playerRight1 = LoadTexture("assets/MagoWalkR1.png");
-    Texture2D playerRight2 = LoadTexture("assets/MagoWalkR2.png");
     player = ecs.createEntity();
     ecs.addComponent(player, Position{{100.0f, 100.0f}});
     ecs.addComponent(player, Velocity{{0, 0}});
-    Sprite playerSprite{playerIdle1};
-    playerSprite.isSheet = false;  // Separate mode
+    Sprite playerSprite{atlasTex};
+    playerSprite.isSheet = true;  // frameRec = región del atlas
+    playerSprite.frameRec = frame("assets/MagoIdel1.png");
     ecs.addComponent(player, playerSprite);
     Animation playerAnim;
-    playerAnim.mode = AnimationMode::Separate;
+    playerAnim.mode = AnimationMode::Sheet;
     playerAnim.frameTime = 0.15f;
-    playerAnim.texStates["idle"] = {playerIdle1,playerIdle2,playerIdle3,playerIdle4};
-    playerAnim.texStates["walk_left"] = {playerLeft1, playerLeft2};
-    playerAnim.texStates["walk_right"] = {playerRight1, playerRight2};
+    playerAnim.rectStates[(int)AnimState::Idle] = {frame("assets/MagoIdel1.png"), frame("assets/MagoIdel2.png"),
+                                     frame("assets/MagoIdel3.png"), frame("assets/MagoIdel4.png")};
+    playerAnim.rectStates[(int)AnimState::WalkLeft] = {frame("assets/MagoWalkL1.png"), frame("assets/MagoWalkL2.png")};
+    playerAnim.rectStates[(int)AnimState::WalkRight] = {frame("assets/MagoWalkR1.png"), frame("assets/MagoWalkR2.png")};
     ecs.addComponent(player, playerAnim);
     ecs.addComponent(player, InputControlled{});
 
     ecs.getComponent<Sprite>(player)->scale = {4.0f, 4.0f};  // 16x16 -> 64x64, visible en 800x600
+    ecs.addComponent(player, Size{playerSprite.frameRec.width * 4.0f, playerSprite.frameRec.height * 4.0f});  // Hitbox = sprite escalado
     
     // Después de player setup
     tilemapEnt = ecs.createEntity();
     TileMap tilemap;
-    tilemap.tileset = LoadTexture("assets/tileset.png");  // Asume existe
-    if (tilemap.tileset.id == 0) {
+    Rectangle tilesetRect = frame("assets/tileset.png");
+    tilemap.tileset = atlasTex;
+    tilemap.tilesetOrigin = {tilesetRect.x, tilesetRect.y};
+    if (tilesetRect.width <= 0) {
         std::cerr << "Error: Tileset load failed! Check path 'assets/tileset.png'" << std::endl;
     } else {
-        std::cout << "Tileset loaded: width=" << tilemap.tileset.width << ", height=" << tilemap.tileset.height << std::endl;
+        std::cout << "Tileset loaded: width=" << tilesetRect.width << ", height=" << tilesetRect.height << std::endl;
     }
 
-    tilemap.wallTex = LoadTexture("assets/wall.png");  // Ajusta path—tu sprite para NON_WALKABLE specials
-    tilemap.hazardTex = LoadTexture("assets/hazard.png");  // Para HAZARD
-    tilemap.pickupTex = LoadTexture("assets/pickup.png");   // Para PICKUP
+    tilemap.wallSrc = frame("assets/wall.png");  // Ajusta path—tu sprite para NON_WALKABLE specials
+    tilemap.hazardSrc = frame("assets/hazard.png");  // Para HAZARD
+    tilemap.pickupSrc = frame("assets/pickup.png");   // Para PICKUP
+    // Sin región no hay special (el autotiling cae al tileset)
+    tilemap.wallTex = tilemap.wallSrc.width > 0 ? atlasTex : Texture2D{0};
+    tilemap.hazardTex = tilemap.hazardSrc.width > 0 ? atlasTex : Texture2D{0};
+    tilemap.pickupTex = tilemap.pickupSrc.width > 0 ? atlasTex : Texture2D{0};
 
-    if (tilemap.wallTex.id == 0) std::cerr << "Wall tex load failed!" << std::endl;
-    if (tilemap.hazardTex.id == 0) std::cerr << "Hazard tex load failed!" << std::endl;
-    if (tilemap.pickupTex.id == 0) std::cerr << "Pickup tex load failed!" << std::endl;
+    if (!textureLoaded(tilemap.wallTex)) std::cerr << "Wall tex load failed!" << std::endl;
+    if (!textureLoaded(tilemap.hazardTex)) std::cerr << "Hazard tex load failed!" << std::endl;
+    if (!textureLoaded(tilemap.pickupTex)) std::cerr << "Pickup tex load failed!" << std::endl;
 
-    // Procedural gen inicial: Un chunk central
-    // unsigned int seed = 12345;
-    unsigned int seed = time(NULL);  // Fijo para test (cambia a time(NULL) para random)
-    PerlinNoise perlin(seed);
+    // Procedural gen inicial: Un chunk central. El miembro perlin también genera las expansiones
+    tilemap.seed = seed;
+    perlin = PerlinNoise(seed);
 
     // Inicial gen: Un chunk central
     tilemap.tiles.reserve(tilemap.maxWidth * tilemap.maxHeight);  // Pre-allocate max para evitar reallocs
@@ -76,11 +94,15 @@ void AdventureScene::setup() {
     int worldOffsetX = 0;
     int worldOffsetY = 0;
     generateChunk(tilemap, worldOffsetX, worldOffsetY, perlin);
+    progress.set(0.3f);
 
     ecs.addComponent(tilemapEnt, tilemap);
 
     // Autotiling después de gen
     systemAutoTiling(ecs);
+    progress.set(0.5f);
+    pathfinder.sync(*ecs.getComponent<TileMap>(tilemapEnt));
+    progress.set(0.7f);
 
     // Añadir Health y Score a player
     ecs.addComponent(player, Health{});
@@ -97,57 +119,78 @@ void AdventureScene::setup() {
     ecs.addComponent(cameraEnt, camComp);
 
 
-    // Enemigo 1: Tracking (persigue player si cerca)
-    Entity enemyTracking = ecs.createEntity();
-    ecs.addComponent(enemyTracking, Position{{600.0f, 300.0f}});
-    ecs.addComponent(enemyTracking, Velocity{{0, 0}});
-    Sprite enemySprite = {playerIdle1};  // Reuse, pero tint RED para diferenciar
-    enemySprite.tint = RED;
-    enemySprite.isSheet = false;
+    // Prefabs de enemies: defaults en código, overrides opcionales desde assets/prefabs.txt
+    Sprite enemySprite = playerSprite;  // Reuse mago, tint por prefab para diferenciar
     enemySprite.scale = {4.0f, 4.0f};
-    ecs.addComponent(enemyTracking, enemySprite);
     Animation enemyAnim = playerAnim;  // Reuse
-    ecs.addComponent(enemyTracking, enemyAnim);
+
     MovementPattern trackPat;
-    trackPat.type = MovementType::Tracking;
-    trackPat.target = player;
+    trackPat.setTracking();
     trackPat.speed = 150.0f;
-    trackPat.pursuitDistance = 400.0f;
-    trackPat.lerpFactor = 0.05f;  // Suave
-    ecs.addComponent(enemyTracking, trackPat);
+    trackPat.tracking.pursuitDistance = 400.0f;
+    trackPat.tracking.lerpFactor = 0.05f;  // Suave
+    enemySprite.tint = RED;
+    prefabs.add("enemy_tracking").with(Position{}).with(Velocity{{0, 0}}).with(enemySprite).with(enemyAnim).with(trackPat);
 
-    // Enemigo 2: Circular (orbita punto fijo)
-    Entity enemyCircular = ecs.createEntity();
-    ecs.addComponent(enemyCircular, Position{{400.0f, 300.0f}});
-    ecs.addComponent(enemyCircular, Velocity{{0, 0}});
-    enemySprite.tint = GREEN;
-    ecs.addComponent(enemyCircular, enemySprite);
-    ecs.addComponent(enemyCircular, enemyAnim);
     MovementPattern circPat;
-    circPat.type = MovementType::Circular;
-    circPat.center = {400.0f, 300.0f};  // Fijo
-    circPat.radius = 150.0f;
-    circPat.angularSpeed = 1.5f;
-    circPat.currentAngle = 0.0f;
+    circPat.setCircular();
+    circPat.circular.radius = 150.0f;
+    circPat.circular.angularSpeed = 1.5f;
     circPat.speed = 0;  // No usado, pero set por consistencia
-    ecs.addComponent(enemyCircular, circPat);
+    enemySprite.tint = GREEN;
+    prefabs.add("enemy_circular").with(Position{}).with(Velocity{{0, 0}}).with(enemySprite).with(enemyAnim).with(circPat);
 
-    // Enemigo 3: Patrol (triángulo loop)
-    Entity enemyPatrol = ecs.createEntity();
-    ecs.addComponent(enemyPatrol, Position{{100.0f, 500.0f}});
-    ecs.addComponent(enemyPatrol, Velocity{{0, 0}});
-    enemySprite.tint = BLUE;
-    ecs.addComponent(enemyPatrol, enemySprite);
-    ecs.addComponent(enemyPatrol, enemyAnim);
     MovementPattern patPat;
-    patPat.type = MovementType::Patrol;
-    patPat.waypoints = {{100.0f, 500.0f}, {300.0f, 600.0f}, {200.0f, 400.0f}};
+    patPat.setPatrol();
     patPat.speed = 120.0f;
-    patPat.loop = true;
-    patPat.arrivalThreshold = 10.0f;
-    ecs.addComponent(enemyPatrol, patPat);
+    patPat.patrol.arrivalThreshold = 10.0f;
+    enemySprite.tint = BLUE;
+    prefabs.add("enemy_patrol").with(Position{}).with(Velocity{{0, 0}}).with(enemySprite).with(enemyAnim).with(patPat)
+        .with(PatrolRoute{});  // Ruta por instancia (abajo); loop desde el prefab
+
+    // Enemies de los spawners: pattern y tint se sortean por spawn (systemEnemySpawn)
+    enemySprite.tint = WHITE;
+    prefabs.add("enemy_spawned").with(Position{}).with(Velocity{{0, 0}}).with(enemySprite).with(enemyAnim)
+        .with(MovementPattern{}).with(SpawnedBy{});
 
+    prefabs.loadFile("assets/prefabs.txt");
+    progress.set(0.8f);
 
+    // Hitbox = sprite escalado (después del load: la escala puede venir del archivo)
+    for (const char* name : {"enemy_tracking", "enemy_circular", "enemy_patrol", "enemy_spawned"}) {
+        Prefab* prefab = prefabs.find(name);
+        prefab->with(spriteSize(*prefab->get<Sprite>()));
+    }
+    spawnPrefab = prefabs.find("enemy_spawned");
+
+    // Enemigo 1: Tracking (persigue player si cerca)
+    ecs.instantiate(*prefabs.find("enemy_tracking"), 1, [&](Entity e, size_t) {
+        ecs.getComponent<Position>(e)->pos = {600.0f, 300.0f};
+        ecs.getComponent<MovementPattern>(e)->target = player;
+    });
+
+    // Enemigo 2: Circular (orbita punto fijo)
+    ecs.instantiate(*prefabs.find("enemy_circular"), 1, [&](Entity e, size_t) {
+        ecs.getComponent<Position>(e)->pos = {400.0f, 300.0f};
+        ecs.getComponent<MovementPattern>(e)->circular.center = {400.0f, 300.0f};  // Fijo
+    });
+
+    // Enemigo 3: Patrol (triángulo loop, rodeando muros)
+    ecs.instantiate(*prefabs.find("enemy_patrol"), 1, [&](Entity e, size_t) {
+        ecs.getComponent<Position>(e)->pos = {100.0f, 500.0f};
+        auto* pat = ecs.getComponent<MovementPattern>(e);
+        auto* route = ecs.getComponent<PatrolRoute>(e);
+        auto* size = ecs.getComponent<Size>(e);
+        std::vector<Vector2> stops = {{100.0f, 500.0f}, {300.0f, 600.0f}, {200.0f, 400.0f}};
+        if (!buildPatrolRoute(pathfinder, stops, {size->w / 2.0f, size->h / 2.0f}, route->points)) {
+            route->points.assign(stops.data(), stops.data() + stops.size());
+        }
+        syncPatrolRoute(*pat, *route);
+    });
+
+
+
+    enemyPool.reserve(enemyPool.maxLive);  // Slots del pool pre-reservados: despawn sin realloc
 
     // Spawner 1: LineHorizontal (e.g., fila de enemigos como alarma horizontal)
     Entity spawnerLineH = ecs.createEntity();
@@ -184,57 +227,43 @@ void AdventureScene::setup() {
     spawnR.areaSize = {300.0f, 200.0f};
     spawnR.activeDistance = 400.0f;
     ecs.addComponent(spawnerRand, spawnR);
-
-
+    progress.set(1.0f);
 }
 
 
 
 void AdventureScene::generateChunk(TileMap& tilemap, int offsetX, int offsetY, PerlinNoise& perlin) {
-    const int chunkSize = tilemap.chunkSize;  // Precompute const
-    for (int y = 0; y < chunkSize; ++y) {
-        for (int x = 0; x < chunkSize; ++x) {
-            int globalX = x + offsetX * chunkSize;
-            int globalY = y + offsetY * chunkSize;
-            int localY = y + (offsetY >= 0 ? offsetY * chunkSize : 0);  // Ajuste para negative offsets
-            int localX = x + (offsetX >= 0 ? offsetX * chunkSize : 0);
-            int index = localY * tilemap.width + localX;
-
-            double noiseVal = perlin.noise(globalX * frequency, globalY * frequency);
-
-            if (noiseVal > thresholdWall) {
-                tilemap.tiles[index].value = IntGridValue::NON_WALKABLE;
-            } else if (noiseVal < thresholdHazard) {
-                tilemap.tiles[index].value = IntGridValue::HAZARD;
-            } else {
-                tilemap.tiles[index].value = IntGridValue::WALKABLE;
-            }
-
-            // Random pickups en walkable (raro, ~2%)
-            if (tilemap.tiles[index].value == IntGridValue::WALKABLE && GetRandomValue(0, 100) < 2) {
-                tilemap.tiles[index].value = IntGridValue::PICKUP;
-            }
-        }
-    }
+    generateChunkTiles(tilemap, offsetX, offsetY, perlin, genParams);
 }
 
 
 
 void AdventureScene::update(float dt) {
+    spriteCuller.markMoved();  // Solo re-ubica sprites con Velocity (el shift por expansión invalida aparte)
     systemInput(ecs);
-    systemAI(ecs, dt);
+    // Recompute del flow field solo si el player cambió de tile o el mapa cambió
+    if (auto* tm = ecs.getComponent<TileMap>(tilemapEnt)) {
+        if (auto* ppos = ecs.getComponent<Position>(player)) {
+            auto* psize = ecs.getComponent<Size>(player);
+            Vector2 goal = psize ? Vector2{ppos->pos.x + psize->w / 2.0f, ppos->pos.y + psize->h / 2.0f} : ppos->pos;
+            flowField.requestIfChanged(*tm, goal);
+        }
+    }
+    aiLod.update(ecs, dt, &flowField);  // systemAI time-sliced por distancia a cámara
     systemTileInteractions(ecs, dt);
     systemMovement(ecs, dt);
+    systemContactDamage(ecs, enemyGrid, dt);
     systemAnimationUpdate(ecs, dt);
-    systemEnemySpawn(ecs, dt);
+    if (auto* tm = ecs.getComponent<TileMap>(tilemapEnt)) pathfinder.sync(*tm);  // No-op si no cambió
+    systemEnemySpawn(ecs, dt, *spawnPrefab, &pathfinder, &enemyPool);
     // Agrega lógica de juego, e.g., colisiones si expandes
     systemCameraUpdate(ecs, dt);
 
     // Opt: Cooldown para check expansión (e.g., cada 0.2s para evitar multiples triggers)
-    static float expansionCooldown = 0.0f;
     expansionCooldown -= dt;
     if (expansionCooldown > 0.0f) return;
     expansionCooldown = 0.2f;  // Reset, aumentado para stability
+    PROFILE_ZONE("AdventureScene::expansion");
 
     // Después de systemMovement
     auto* pos = ecs.getComponent<Position>(player);
@@ -298,15 +327,24 @@ void AdventureScene::update(float dt) {
                 float offsetX = static_cast<float>(tilemap->chunkSize) * tilemap->tileSize * tilemap->scale;
                 for (auto& [ent, comp] : ecs.getComponentMap<Position>()) {
                     comp.pos.x += offsetX;
+                    comp.prev.x += offsetX;
+                }
+                spriteCuller.invalidate();  // Todo el mundo se movió, incluidos los sprites sin Velocity
+                for (auto& [ent, cam] : ecs.getComponentMap<CameraComp>()) {
+                    cam.cam.target.x += offsetX;
+                    cam.prevTarget.x += offsetX;
                 }
                 // Adjust pattern params fijos
+                for (auto& [ent, route] : ecs.getComponentMap<PatrolRoute>()) {
+                    for (auto& wp : route.points) {
+                        wp.x += offsetX;
+                    }
+                }
                 for (auto& [ent, pat] : ecs.getComponentMap<MovementPattern>()) {
                     if (pat.type == MovementType::Patrol) {
-                        for (auto& wp : pat.waypoints) {
-                            wp.x += offsetX;
-                        }
+                        pat.patrol.waypoint.x += offsetX;  // Cache de la ruta
                     } else if (pat.type == MovementType::Circular && !pat.aroundTarget) {
-                        pat.center.x += offsetX;
+                        pat.circular.center.x += offsetX;
                     }
                 }
                 // Adjust spawners centers
@@ -340,15 +378,24 @@ void AdventureScene::update(float dt) {
                 float offsetY = static_cast<float>(tilemap->chunkSize) * tilemap->tileSize * tilemap->scale;
                 for (auto& [ent, comp] : ecs.getComponentMap<Position>()) {
                     comp.pos.y += offsetY;
+                    comp.prev.y += offsetY;
+                }
+                spriteCuller.invalidate();
+                for (auto& [ent, cam] : ecs.getComponentMap<CameraComp>()) {
+                    cam.cam.target.y += offsetY;
+                    cam.prevTarget.y += offsetY;
                 }
                 // Adjust pattern params fijos
+                for (auto& [ent, route] : ecs.getComponentMap<PatrolRoute>()) {
+                    for (auto& wp : route.points) {
+                        wp.y += offsetY;
+                    }
+                }
                 for (auto& [ent, pat] : ecs.getComponentMap<MovementPattern>()) {
                     if (pat.type == MovementType::Patrol) {
-                        for (auto& wp : pat.waypoints) {
-                            wp.y += offsetY;
-                        }
+                        pat.patrol.waypoint.y += offsetY;  // Cache de la ruta
                     } else if (pat.type == MovementType::Circular && !pat.aroundTarget) {
-                        pat.center.y += offsetY;
+                        pat.circular.center.y += offsetY;
                     }
                 }
                 // Adjust spawners centers
@@ -359,7 +406,7 @@ void AdventureScene::update(float dt) {
             }
 
             if (dirty) {
-                // No needed con chunk autotile, pero mantiene por si
+                tilemap->revision++;  // Invalida flow field y demás caches por tile
             }
         }
     }
@@ -367,58 +414,45 @@ void AdventureScene::update(float dt) {
 
 
 
-void AdventureScene::render() {
-    // Get camera
+void AdventureScene::render(RenderQueue& queue) {
+    // Get camera (la queue la aplica a los layers world space en el replay)
     auto* camComp = ecs.getComponent<CameraComp>(cameraEnt);
+    Camera2D cam = {};
     if (camComp) {
-        BeginMode2D(camComp->cam);
+        cam = interpolatedCamera(*camComp, renderAlpha);
+        queue.setCamera(cam);
     }
 
-    // Render map y entities
-    systemRenderTileMap(ecs);
-    systemRenderSprites(ecs);
+    // Render map y entities (resúmenes por chunk: solo se rearman los chunks que cambiaron)
+    auto* tilemap = ecs.getComponent<TileMap>(tilemapEnt);
+    if (tilemap) chunkSummaries.sync(*tilemap, AssetManager::instance().ready(atlas));
+    systemRenderTileMap(ecs, queue, &chunkSummaries);
+    systemRenderSprites(ecs, queue, renderAlpha, &spriteCuller);
 
     // Debug spawners (solo si toggleado)
     if (debugSpawners) {
-        systemDebugSpawners(ecs);
-    }
-
-    if (camComp) {
-        EndMode2D();
+        Rectangle view = camComp ? cameraViewRect(cam) : Rectangle{0, 0, (float)screen_width, (float)screen_height};
+        systemDebugSpawners(ecs, spawnerOverlay, queue, view);
     }
 
-    // Health/Score (fixed UI, fuera de camera para no scroll)
+    // Health/Score (layer Hud: screen space, fuera de camera para no scroll)
     if (auto* health = ecs.getComponent<Health>(player)) {
-        DrawText(TextFormat("Health: %.0f", health->value), 10, 30, 20, RED);
+        queue.main().text(RenderLayer::Hud, TextFormat("Health: %.0f", health->value), 10, 30, 20, RED);
     }
     if (auto* score = ecs.getComponent<Score>(player)) {
-        DrawText(TextFormat("Score: %d", score->value), 10, 50, 20, GREEN);
-    }
-}
-
-void AdventureScene::clean() {
-    
-    // Similar para player (repíte código o haz función helper)
-    if (auto* playerAnim = ecs.getComponent<Animation>(player)) {
-        if (playerAnim->mode == AnimationMode::Sheet) {
-            UnloadTexture(ecs.getComponent<Sprite>(player)->texture);
-        } else {
-            for (auto& [state, frames] : playerAnim->texStates) {
-                for (auto& tex : frames) UnloadTexture(tex);
-            }
-        }
+        queue.main().text(RenderLayer::Hud, TextFormat("Score: %d", score->value), 10, 50, 20, GREEN);
     }
 
-    if (auto* tm = ecs.getComponent<TileMap>(tilemapEnt)) {
-        UnloadTexture(tm->tileset);
-    }
-
-
-    if (auto* tm = ecs.getComponent<TileMap>(tilemapEnt)) {
-        UnloadTexture(tm->tileset);
-        UnloadTexture(tm->wallTex);
-        UnloadTexture(tm->hazardTex);
-        UnloadTexture(tm->pickupTex);
+    // Minimapa desde la página del nivel más grueso: un quad, sin recorrer tiles
+    if (showMinimap && tilemap && camComp) {
+        Vector2 playerPos = {0, 0};
+        if (auto* pos = ecs.getComponent<Position>(player)) playerPos = interpolatedPosition(*pos, renderAlpha);
+        chunkSummaries.submitMinimap(*tilemap, queue.main(), {screen_width - 170.0f, 10.0f, 160.0f, 160.0f}, cameraViewRect(cam), playerPos);
     }
+}
 
+void AdventureScene::clean() {
+    // Player, enemies y tilemap referencian sub-rects del mismo atlas: un solo release
+    chunkSummaries.clear();
+    AssetManager::instance().release(atlas);
 }
\ No newline at end of file
@@ -3,9 +3,10 @@
 #include <iostream>
 #include "../print.h"
 
-BreakoutScene::BreakoutScene(int width, int height) : screen_width(width), screen_height(height) {}
+BreakoutScene::BreakoutScene(int width, int height, std::string levelPath)
+    : screen_width(width), screen_height(height), levelPath(std::move(levelPath)) {}
 
-void BreakoutScene::setup() {
+void BreakoutScene::load(LoadProgress& progress) {
     // Mismo código de Game::setup anterior
     paddle = ecs.createEntity();
     ecs.addComponent(paddle, Position{screen_width / 2.f - 50.f, screen_height - 40.f});
@@ -13,46 +14,59 @@ void BreakoutScene::setup() {
     ecs.addComponent(paddle, Velocity{0.f, 0.f});
     ecs.addComponent(paddle, PaddleControlled{});
 
-    ball = ecs.createEntity();
-    ecs.addComponent(ball, Position{screen_width / 2.f - 7.5f, screen_height / 2.f - 7.5f});
-    ecs.addComponent(ball, Size{15.f, 15.f});
-    ecs.addComponent(ball, Velocity{0.f, -150.f});
-    ecs.addComponent(ball, Ball{});
-
-    const int cols = 4;
-    const int rows = 2;
-    const float blockWidth = screen_width / (float)cols;
-    const float blockHeight = 20.f;
-
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            Entity block = ecs.createEntity();
-            ecs.addComponent(block, Position{x * blockWidth + 2, y * (blockHeight + 5) + 40});
-            ecs.addComponent(block, Size{blockWidth - 4, blockHeight});
-            ecs.addComponent(block, Block{});
-        }
+    // Nuevo: bloques en BlockGrid (bitset + hp) y balls en SoA, desde el archivo de nivel
+    BlockGrid grid;
+    BallSet balls;
+    if (!loadBreakoutLevel(levelPath, grid, balls, screen_width)) {
+        const int cols = 4;
+        const int rows = 2;
+        grid.resize(cols, rows);
+        grid.cellW = screen_width / (float)cols;
+        grid.cellH = 25.f;
+        grid.origin = {0.f, 40.f};
+        grid.gap = 4.f;
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x) grid.set(x, y, 1);
+        balls = BallSet{};
+        spawnBalls(balls, 1, 15.f, 150.f, screen_height / 2.f, screen_width);
     }
+    progress.set(0.5f);
+
+    level = ecs.createEntity();
+    ecs.addComponent(level, std::move(grid));
+    ecs.addComponent(level, std::move(balls));
+    progress.set(1.0f);
 }
 
 void BreakoutScene::update(float dt) {
+    if (!isRunning) return;
     systemPaddleControl(ecs, dt, screen_width);
-    systemBallMovement(ecs, dt, screen_width, screen_height, isRunning);
-    systemBallPaddleCollision(ecs);
-    systemBallBlockCollision(ecs);
+    systemBreakoutBalls(ecs, dt, screen_width, screen_height, stepStats);  // Sweep por celdas + kernel SIMD
 
-    if (ecs.getComponentMap<Block>().empty()) {
+    auto* grid = ecs.getComponent<BlockGrid>(level);
+    auto* balls = ecs.getComponent<BallSet>(level);
+    if (grid && grid->aliveCount == 0) {
         std::cout << "You Win!" << std::endl;
         isRunning = false;  // Podrías signal al manager para switch scene
+    } else if (balls && balls->count() == 0) {
+        std::cout << "*****Game Over*****" << std::endl;
+        isRunning = false;
     }
 
 #ifdef DEBUG
-    auto* ballPos = ecs.getComponent<Position>(ball);
-    if (ballPos) vprint(*ballPos);
+    if (balls && balls->count() > 0) vprint(balls->y[0]);
 #endif
 }
 
-void BreakoutScene::render() {
-    systemRender(ecs);
+void BreakoutScene::render(RenderQueue& queue) {
+    systemRender(ecs, queue, renderAlpha);  // Paddle
+    systemRenderBreakout(ecs, queue, renderAlpha);
+
+    auto* grid = ecs.getComponent<BlockGrid>(level);
+    auto* balls = ecs.getComponent<BallSet>(level);
+    if (grid && balls) {
+        queue.main().text(RenderLayer::Hud, TextFormat("Balls: %d  Blocks: %d", (int)balls->count(), grid->aliveCount), 10, 10, 20, DARKGRAY);
+    }
 }
 
 void BreakoutScene::clean() {
@@ -1,21 +1,28 @@
 // src/scenes/MenuScene.cpp
 #include "MenuScene.h"
+#include "platform.h"
 
 MenuScene::MenuScene() {}
 
-void MenuScene::setup() {
+void MenuScene::load(LoadProgress& progress) {
     // Setup menú: Por ahora, solo flags; en futuro, entidades UI
+    progress.set(1.0f);
 }
 
 void MenuScene::update(float dt) {
     // Lógica de input: e.g., si presiona space, startGame = true
-    if (IsKeyPressed(KEY_SPACE)) {
+    if (inputKeyPressed(KEY_SPACE)) {
         startGame = true;
     }
+    if (inputKeyPressed(KEY_S)) {
+        startStress = true;
+    }
 }
 
-void MenuScene::render() {
-    DrawText("Presiona SPACE para empezar Breakout", 100, 200, 20, BLACK);
+void MenuScene::render(RenderQueue& queue) {
+    CommandBuffer& out = queue.main();
+    out.text(RenderLayer::Hud, "Presiona SPACE para empezar Breakout", 100, 200, 20, BLACK);
+    out.text(RenderLayer::Hud, "Presiona S para StressScene", 100, 230, 20, BLACK);
     // En futuro, render UI entities
 }
 
@@ -0,0 +1,17 @@
+// src/scenes/SceneFactory.cpp
+#include "Scene.h"
+#include "scenes/MenuScene.h"
+#include "scenes/BreakoutScene.h"
+#include "scenes/AdventureScene.h"
+#include "scenes/StressScene.h"
+#include <iostream>
+
+std::unique_ptr<Scene> createScene(const std::string& name, int width, int height) {
+    if (name == "Menu") return std::make_unique<MenuScene>();
+    if (name == "Breakout") return std::make_unique<BreakoutScene>(width, height);
+    if (name == "BreakoutStress") return std::make_unique<BreakoutScene>(width, height, "assets/levels/breakout_stress.txt");
+    if (name == "Adventure") return std::make_unique<AdventureScene>(width, height);
+    if (name == "Stress") return std::make_unique<StressScene>(width, height);
+    std::cerr << "Unknown scene: " << name << std::endl;
+    return nullptr;
+}
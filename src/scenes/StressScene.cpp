@@ -0,0 +1,281 @@
+// src/scenes/StressScene.cpp
+#include "scenes/StressScene.h"
+#include "platform.h"
+#include "assets.h"
+#include "profiler.h"
+#include "perlin.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+using StressClock = std::chrono::steady_clock;
+
+static float msSince(StressClock::time_point start) {
+    return std::chrono::duration<float, std::milli>(StressClock::now() - start).count();
+}
+
+StressScene::StressScene(int width, int height) : screen_width(width), screen_height(height) {}
+
+void StressScene::beginLoad() {
+    AssetManager& assets = AssetManager::instance();
+    atlas = assets.acquireAtlas("stress", {"assets/MagoIdel1.png", "assets/MagoIdel2.png", "assets/MagoIdel3.png",
+                                           "assets/MagoIdel4.png", "assets/tileset.png"});
+    atlasTex = assets.get(atlas);
+    atlasRegions = assets.regions(atlas);
+}
+
+void StressScene::load(LoadProgress& progress) {
+    setRandomSeed(1234);  // Misma distribución en cada corrida: curvas comparables
+
+    auto frame = [&](const char* path) {
+        auto it = atlasRegions.find(path);
+        return it != atlasRegions.end() ? it->second : Rectangle{0, 0, 0, 0};
+    };
+    Rectangle idle[4] = {frame("assets/MagoIdel1.png"), frame("assets/MagoIdel2.png"), frame("assets/MagoIdel3.png"),
+                         frame("assets/MagoIdel4.png")};
+
+    // Mapa grande pre-generado (sin expansión)
+    tilemapEnt = ecs.createEntity();
+    TileMap tilemap;
+    Rectangle tilesetRect = frame("assets/tileset.png");
+    tilemap.tileset = atlasTex;
+    tilemap.tilesetOrigin = {tilesetRect.x, tilesetRect.y};
+    tilemap.width = tilemap.height = tilemap.chunkSize * config.mapChunks;
+    tilemap.maxWidth = tilemap.width;
+    tilemap.maxHeight = tilemap.height;
+    tilemap.tiles.resize(tilemap.width * tilemap.height);
+    PerlinNoise perlin(1234);
+    ChunkGenParams params;
+    params.thresholdHazard = -1.0f;  // Sin hazards: el player no muere durante la medición
+    for (int cy = 0; cy < config.mapChunks; ++cy) {
+        for (int cx = 0; cx < config.mapChunks; ++cx) generateChunkTiles(tilemap, cx, cy, perlin, params);
+        progress.set(0.4f * (cy + 1) / config.mapChunks);
+    }
+    for (int i = 0; i < (int)tilemap.tiles.size(); ++i) {
+        if (tilemap.tiles[i].value == IntGridValue::WALKABLE) walkableTiles.push_back(i);
+    }
+    ecs.addComponent(tilemapEnt, tilemap);
+    systemAutoTiling(ecs);
+    progress.set(0.6f);
+
+    // Player en el centro: target de Tracking y referencia de spawners
+    Sprite sprite{atlasTex};
+    sprite.frameRec = idle[0];
+    sprite.scale = {4.0f, 4.0f};
+    Animation anim;
+    anim.mode = AnimationMode::Sheet;
+    anim.frameTime = 0.15f;
+    anim.rectStates[(int)AnimState::Idle] = {idle[0], idle[1], idle[2], idle[3]};
+    Size size{idle[0].width * 4.0f, idle[0].height * 4.0f};
+
+    player = ecs.createEntity();
+    ecs.addComponent(player, Position{randomWalkablePos()});
+    ecs.addComponent(player, Velocity{{0, 0}});
+    ecs.addComponent(player, sprite);
+    ecs.addComponent(player, anim);
+    ecs.addComponent(player, size);
+    ecs.addComponent(player, InputControlled{});
+    ecs.addComponent(player, Health{});
+    ecs.addComponent(player, Score{});
+
+    camera = ecs.createEntity();
+    CameraComp camComp;
+    camComp.cam.offset = {screen_width / 2.0f, screen_height / 2.0f};
+    camComp.cam.target = ecs.getComponent<Position>(player)->pos;
+    camComp.cam.zoom = 0.5f;
+    camComp.prevTarget = camComp.cam.target;
+    camComp.target = player;
+    ecs.addComponent(camera, camComp);
+
+    // Prefabs por grupo (instantiate en batch al subir counts)
+    sprite.tint = LIGHTGRAY;
+    prefabs.add("stress_sprite").with(Position{}).with(sprite).with(anim);
+    MovementPattern pat;
+    pat.target = player;
+    pat.speed = 120.0f;
+    pat.setTracking();
+    pat.tracking.pursuitDistance = 0.0f;  // Siempre persigue
+    sprite.tint = RED;
+    prefabs.add("stress_tracking").with(Position{}).with(Velocity{{0, 0}}).with(size).with(sprite).with(anim).with(pat);
+    pat.setCircular();
+    sprite.tint = GREEN;
+    prefabs.add("stress_circular").with(Position{}).with(Velocity{{0, 0}}).with(size).with(sprite).with(anim).with(pat);
+    pat.setPatrol();
+    sprite.tint = BLUE;
+    prefabs.add("stress_patrol").with(Position{}).with(Velocity{{0, 0}}).with(size).with(sprite).with(anim).with(pat)
+        .with(PatrolRoute{});
+    // Enemies de los spawners: pattern y tint por spawn (systemEnemySpawn)
+    sprite.tint = WHITE;
+    spawnPrefab = &prefabs.add("stress_spawned").with(Position{}).with(Velocity{{0, 0}}).with(spriteSize(sprite)).with(sprite)
+        .with(anim).with(MovementPattern{}).with(SpawnedBy{});
+
+    enemyPool.maxLive = 100000;
+    applyCounts();
+    progress.set(1.0f);
+}
+
+Vector2 StressScene::randomWalkablePos() {
+    auto* tm = ecs.getComponent<TileMap>(tilemapEnt);
+    if (!tm || walkableTiles.empty()) return {0, 0};
+    int idx = walkableTiles[randomValue(0, (int)walkableTiles.size() - 1)];
+    float tileWorld = tm->tileSize * tm->scale;
+    return {(idx % tm->width) * tileWorld, (idx / tm->width) * tileWorld};
+}
+
+int StressScene::getEntityCount() const {
+    int total = 2;  // player + camera
+    for (const auto& group : groups) total += (int)group.size();
+    return total + enemyPool.getLive();
+}
+
+void StressScene::resize(Group group, int target) {
+    std::vector<Entity>& list = groups[group];
+    if (target < 0) target = 0;
+
+    // Quitar: desde el final (las más nuevas)
+    while ((int)list.size() > target) {
+        ecs.removeEntity(list.back());
+        list.pop_back();
+    }
+    if ((int)list.size() == target) return;
+
+    const size_t count = target - list.size();
+    if (group == Spawners) {
+        static const SpawnType types[4] = {SpawnType::LineHorizontal, SpawnType::LineVertical, SpawnType::Circular, SpawnType::RandomArea};
+        for (size_t i = 0; i < count; ++i) {
+            Entity e = ecs.createEntity();
+            EnemySpawner spawner;
+            spawner.type = types[list.size() % 4];
+            spawner.center = randomWalkablePos();
+            spawner.frequency = 2.0f;
+            spawner.minEnemies = 2;
+            spawner.maxEnemies = 4;
+            spawner.activeDistance = 0.0f;   // Siempre activo
+            spawner.despawnDistance = 0.0f;  // Nunca despawnea: satura en maxAlive
+            spawner.maxAlive = 20;
+            ecs.addComponent(e, spawner);
+            list.push_back(e);
+        }
+        return;
+    }
+
+    static const char* prefabNames[4] = {"stress_sprite", "stress_tracking", "stress_circular", "stress_patrol"};
+    Prefab* prefab = prefabs.find(prefabNames[group]);
+    if (!prefab) return;
+    ecs.instantiate(*prefab, count, [&](Entity e, size_t) {
+        Vector2 pos = randomWalkablePos();
+        ecs.getComponent<Position>(e)->pos = pos;
+        if (auto* pat = ecs.getComponent<MovementPattern>(e)) {
+            float angle = (float)randomValue(0, 628) / 100.0f;  // Para todos los tipos: misma secuencia random
+            if (pat->type == MovementType::Circular) {
+                pat->circular.center = pos;
+                pat->circular.currentAngle = angle;
+            }
+            if (auto* route = ecs.getComponent<PatrolRoute>(e)) {  // 4 puntos: inline, sin heap
+                route->points = {pos, {pos.x + 192.0f, pos.y}, {pos.x + 192.0f, pos.y + 192.0f}, {pos.x, pos.y + 192.0f}};
+                syncPatrolRoute(*pat, *route);
+            }
+        }
+        list.push_back(e);
+    });
+}
+
+void StressScene::applyCounts() {
+    const int targets[GroupCount] = {config.sprites, config.tracking, config.circular, config.patrol, config.spawners};
+    bool changed = false;
+    for (int g = 0; g < GroupCount; ++g) changed |= (int)groups[g].size() != targets[g];
+    if (!changed) return;
+
+    closeSample();  // El punto anterior de la curva corresponde a los counts viejos
+    for (int g = 0; g < GroupCount; ++g) resize((Group)g, targets[g]);
+}
+
+void StressScene::closeSample() {
+    if (current.frames == 0) return;
+    const float n = (float)current.frames;
+    StressSample avg = current;
+    avg.simMs /= n;
+    avg.aiMs /= n;
+    avg.movementMs /= n;
+    avg.animationMs /= n;
+    avg.spawnMs /= n;
+    avg.renderMs /= n;
+    curve.push_back(avg);
+    printf("Stress: %7d entities | sim %7.3f ms (ai %.3f, move %.3f, anim %.3f, spawn %.3f) | render %.3f ms | %.0f entities/ms\n",
+           avg.entities, avg.simMs, avg.aiMs, avg.movementMs, avg.animationMs, avg.spawnMs, avg.renderMs,
+           avg.simMs > 0 ? avg.entities / avg.simMs : 0.0f);
+    current = StressSample{};
+}
+
+void StressScene::update(float dt) {
+    if (config.ramp) {
+        rampTimer += dt;
+        if (rampTimer >= config.rampInterval) {
+            rampTimer = 0.0f;
+            if (getEntityCount() < config.rampMax) {
+                for (int* count : {&config.sprites, &config.tracking, &config.circular, &config.patrol}) {
+                    *count = (int)(*count * config.rampFactor) + 1;
+                }
+            } else {
+                config.ramp = false;
+            }
+        }
+    }
+    applyCounts();
+    spriteCuller.markMoved();
+
+    auto frameStart = StressClock::now();
+    systemInput(ecs);
+    if (auto* tm = ecs.getComponent<TileMap>(tilemapEnt)) {
+        flowField.requestIfChanged(*tm, ecs.getComponent<Position>(player)->pos);
+    }
+
+    auto t = StressClock::now();
+    systemAI(ecs, dt, &flowField, &aiBatch);  // Particionado por MovementType
+    current.aiMs += msSince(t);
+
+    t = StressClock::now();
+    systemMovement(ecs, dt);
+    current.movementMs += msSince(t);
+
+    t = StressClock::now();
+    systemAnimationUpdate(ecs, dt);
+    current.animationMs += msSince(t);
+
+    t = StressClock::now();
+    systemEnemySpawn(ecs, dt, *spawnPrefab, nullptr, &enemyPool);
+    current.spawnMs += msSince(t);
+
+    systemCameraUpdate(ecs, dt);
+    current.simMs += msSince(frameStart);
+    current.renderMs += lastRenderMs;
+    current.entities = getEntityCount();
+    ++current.frames;
+
+    // Línea "en vivo" cada segundo (además de un punto de curva por cada cambio de counts)
+    reportTimer += dt;
+    if (reportTimer >= 1.0f && current.frames > 0) {
+        reportTimer = 0.0f;
+        float sim = current.simMs / current.frames;
+        printf("  live: %d entities, sim %.3f ms/frame, %.0f entities/ms\n", current.entities, sim, sim > 0 ? current.entities / sim : 0.0f);
+    }
+}
+
+void StressScene::render(RenderQueue& queue) {
+    auto start = StressClock::now();  // Generación de comandos (el replay lo mide RenderQueue::flush en el profiler)
+    if (auto* camComp = ecs.getComponent<CameraComp>(camera)) queue.setCamera(interpolatedCamera(*camComp, renderAlpha));
+    if (auto* tilemap = ecs.getComponent<TileMap>(tilemapEnt)) chunkSummaries.sync(*tilemap, AssetManager::instance().ready(atlas));
+    systemRenderTileMap(ecs, queue, &chunkSummaries);
+    systemRenderSprites(ecs, queue, renderAlpha, &spriteCuller);
+    lastRenderMs = msSince(start);
+
+    queue.main().text(RenderLayer::Hud, TextFormat("Entities: %d  sim %.2f ms  render %.2f ms", getEntityCount(),
+                                                   current.frames ? current.simMs / current.frames : 0.0f, lastRenderMs), 10, 40, 20, DARKGRAY);
+}
+
+void StressScene::clean() {
+    closeSample();
+    // Las entities mueren con la ECS de la escena; solo quedan las texturas del LOD y el atlas
+    chunkSummaries.clear();
+    AssetManager::instance().release(atlas);
+}
@@ -0,0 +1,136 @@
+// src/spatial.cpp
+#include "spatial.h"
+#include <cmath>
+#include <algorithm>
+
+// Bordes que se tocan cuentan
+static bool overlaps(const Rectangle& a, const Rectangle& b) {
+    return !(a.x > b.x + b.width || a.x + a.width < b.x ||
+             a.y > b.y + b.height || a.y + a.height < b.y);
+}
+
+SpatialGrid::SpatialGrid(float cellSize, uint32_t bucketCount) : cellSize(cellSize), invCellSize(1.0f / cellSize) {
+    // Redondea a potencia de 2 para usar mask en vez de modulo
+    uint32_t buckets = 1;
+    while (buckets < bucketCount) buckets <<= 1;
+    bucketMask = buckets - 1;
+    cellStart.assign(buckets + 1, 0);
+}
+
+void SpatialGrid::clear() {
+    ids.clear();
+    boxes.clear();
+}
+
+void SpatialGrid::insert(Entity e, Rectangle box) {
+    ids.push_back(e);
+    boxes.push_back(box);
+}
+
+int SpatialGrid::cellCoord(float v) const {
+    return (int)floorf(v * invCellSize);
+}
+
+uint32_t SpatialGrid::bucketOf(int cx, int cy) const {
+    return ((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u) & bucketMask;
+}
+
+uint32_t SpatialGrid::nextStamp() {
+    if (stamp.size() < ids.size()) stamp.resize(ids.size(), 0);
+    if (++queryStamp == 0) {  // Overflow: resetea stamps
+        std::fill(stamp.begin(), stamp.end(), 0);
+        queryStamp = 1;
+    }
+    return queryStamp;
+}
+
+void SpatialGrid::build() {
+    entries.clear();
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    // Pass 1: un entry por celda cubierta (items grandes ocupan varias)
+    for (uint32_t i = 0; i < (uint32_t)boxes.size(); ++i) {
+        const Rectangle& b = boxes[i];
+        int x0 = cellCoord(b.x), x1 = cellCoord(b.x + b.width);
+        int y0 = cellCoord(b.y), y1 = cellCoord(b.y + b.height);
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                uint32_t bucket = bucketOf(cx, cy);
+                entries.push_back({bucket, i});
+                cellStart[bucket + 1]++;
+            }
+        }
+    }
+
+    // Prefix sum -> offsets
+    for (size_t b = 1; b < cellStart.size(); ++b) cellStart[b] += cellStart[b - 1];
+
+    // Pass 2: scatter (counting sort estable)
+    cellItems.resize(entries.size());
+    for (auto& [bucket, item] : entries) {
+        cellItems[cellStart[bucket]++] = item;
+    }
+    // El scatter corrió los offsets una posición; restaura
+    for (size_t b = cellStart.size() - 1; b > 0; --b) cellStart[b] = cellStart[b - 1];
+    cellStart[0] = 0;
+}
+
+void SpatialGrid::rebuild(ECS& ecs) {
+    rebuildFrom<Size>(ecs);
+}
+
+template<typename Fn>
+void SpatialGrid::forEachCandidate(Rectangle box, Fn&& fn) {
+    int x0 = cellCoord(box.x), x1 = cellCoord(box.x + box.width);
+    int y0 = cellCoord(box.y), y1 = cellCoord(box.y + box.height);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            uint32_t bucket = bucketOf(cx, cy);
+            for (uint32_t k = cellStart[bucket]; k < cellStart[bucket + 1]; ++k) {
+                fn(cellItems[k]);
+            }
+        }
+    }
+}
+
+void SpatialGrid::queryAABB(Rectangle box, std::vector<Entity>& out) {
+    out.clear();
+    if (ids.empty()) return;
+    uint32_t s = nextStamp();
+    forEachCandidate(box, [&](uint32_t item) {
+        if (stamp[item] == s) return;  // Ya visto (multi-celda o colisión de hash)
+        stamp[item] = s;
+        if (overlaps(boxes[item], box)) out.push_back(ids[item]);
+    });
+}
+
+void SpatialGrid::queryRadius(Vector2 center, float radius, std::vector<Entity>& out) {
+    out.clear();
+    if (ids.empty()) return;
+    uint32_t s = nextStamp();
+    const float r2 = radius * radius;
+    Rectangle box = {center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f};
+    forEachCandidate(box, [&](uint32_t item) {
+        if (stamp[item] == s) return;
+        stamp[item] = s;
+        // Distancia círculo-AABB: punto más cercano del rect al centro
+        const Rectangle& b = boxes[item];
+        float nx = std::clamp(center.x, b.x, b.x + b.width);
+        float ny = std::clamp(center.y, b.y, b.y + b.height);
+        float ddx = center.x - nx, ddy = center.y - ny;
+        if (ddx * ddx + ddy * ddy <= r2) out.push_back(ids[item]);
+    });
+}
+
+void SpatialGrid::queryPairs(std::vector<std::pair<Entity, Entity>>& out) {
+    out.clear();
+    for (uint32_t i = 0; i < (uint32_t)ids.size(); ++i) {
+        uint32_t s = nextStamp();
+        const Rectangle& a = boxes[i];
+        forEachCandidate(a, [&](uint32_t j) {
+            if (j <= i || stamp[j] == s) return;  // Cada par una sola vez (i < j)
+            stamp[j] = s;
+            if (overlaps(a, boxes[j])) out.push_back({ids[i], ids[j]});
+        });
+    }
+}
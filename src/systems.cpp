@@ -1,5 +1,13 @@
 // src/systems.cpp
 #include "systems.h"
+#include "platform.h"
+#include "perlin.h"
+#include "profiler.h"
+#include "culling.h"
+#include "debugoverlay.h"
+#include "chunksummary.h"
+#include "aibatch.h"
+#include "simdmath.h"
 #include <iostream>
 #include <vector>
 #include <cmath>
@@ -7,17 +15,17 @@
 #include <utility>
 #include <cstdlib> 
 #include <cstdint>
+#include <algorithm>
+#include <atomic>
 #include <raymath.h>
+#include "flowfield.h"
+#include "hpa.h"
+#include "pool.h"
+#include "prefab.h"
 
 
-bool checkCollision(const Position& aPos, const Size& aSize, const Position& bPos, const Size& bSize) {
-    return !(aPos.pos.x > bPos.pos.x + bSize.w ||
-             aPos.pos.x + aSize.w < bPos.pos.x ||
-             aPos.pos.y > bPos.pos.y + bSize.h ||
-             aPos.pos.y + aSize.h < bPos.pos.y);
-}
-
 void systemPaddleControl(ECS& ecs, float dt, int screenWidth) {
+    PROFILE_ZONE("systemPaddleControl");
     for (auto& [entity, _] : ecs.getComponentMap<PaddleControlled>()) {
         auto* pos = ecs.getComponent<Position>(entity);
         auto* vel = ecs.getComponent<Velocity>(entity);
@@ -25,8 +33,8 @@ void systemPaddleControl(ECS& ecs, float dt, int screenWidth) {
         if (!pos || !vel || !size) continue;
 
         vel->vel.x = 0;
-        if (IsKeyDown(KEY_LEFT)) vel->vel.x = -300;
-        if (IsKeyDown(KEY_RIGHT)) vel->vel.x = 300;
+        if (inputKeyDown(KEY_LEFT)) vel->vel.x = -300;
+        if (inputKeyDown(KEY_RIGHT)) vel->vel.x = 300;
 
         pos->pos.x += vel->vel.x * dt;
         if (pos->pos.x < 0) pos->pos.x = 0;
@@ -34,294 +42,386 @@ void systemPaddleControl(ECS& ecs, float dt, int screenWidth) {
     }
 }
 
-void systemBallMovement(ECS& ecs, float dt, int screenWidth, int screenHeight, bool& isRunning) {
-    for (auto& [entity, _] : ecs.getComponentMap<Ball>()) {
-        auto* pos = ecs.getComponent<Position>(entity);
-        auto* vel = ecs.getComponent<Velocity>(entity);
-        auto* size = ecs.getComponent<Size>(entity);
-        if (!pos || !vel || !size) continue;
+// Daño por contacto player-enemy (enemies = entidades con MovementPattern + Size)
+void systemContactDamage(ECS& ecs, SpatialGrid& grid, float dt, float damagePerSecond) {
+    PROFILE_ZONE("systemContactDamage");
+    static std::vector<Entity> hits;
 
-        pos->pos.x += vel->vel.x * dt;
-        pos->pos.y += vel->vel.y * dt;
-
-        if (pos->pos.x <= 0) {
-            pos->pos.x = 0;
-            vel->vel.x = -vel->vel.x;
-        } else if (pos->pos.x + size->w >= screenWidth) {
-            pos->pos.x = screenWidth - size->w;
-            vel->vel.x = -vel->vel.x;
-        }
+    grid.rebuildFrom<MovementPattern>(ecs);
+    hits.reserve(ecs.getComponentMap<MovementPattern>().size());  // Cota de hits: realloc solo con más enemies
 
-        if (pos->pos.y <= 0) {
-            pos->pos.y = 0;
-            vel->vel.y = -vel->vel.y;
-        }
+    for (auto& [entity, _] : ecs.getComponentMap<InputControlled>()) {
+        auto* pos = ecs.getComponent<Position>(entity);
+        auto* size = ecs.getComponent<Size>(entity);
+        auto* health = ecs.getComponent<Health>(entity);
+        if (!pos || !size || !health) continue;
 
-        if (pos->pos.y + size->h >= screenHeight) {
-            std::cout << "*****Game Over*****" << std::endl;
-            isRunning = false;
-        }
-    }
-}
+        grid.queryAABB({pos->pos.x, pos->pos.y, size->w, size->h}, hits);
+        if (hits.empty()) continue;
 
-void systemBallPaddleCollision(ECS& ecs) {
-    for (auto& [ballEnt, _] : ecs.getComponentMap<Ball>()) {
-        auto* bPos = ecs.getComponent<Position>(ballEnt);
-        auto* bVel = ecs.getComponent<Velocity>(ballEnt);
-        auto* bSize = ecs.getComponent<Size>(ballEnt);
-        if (!bPos || !bVel || !bSize) continue;
-
-        for (auto& [padEnt, _] : ecs.getComponentMap<PaddleControlled>()) {
-            auto* pPos = ecs.getComponent<Position>(padEnt);
-            auto* pSize = ecs.getComponent<Size>(padEnt);
-            if (!pPos || !pSize) continue;
-
-            if (checkCollision(*bPos, *bSize, *pPos, *pSize)) {
-                bVel->vel.y = -bVel->vel.y * 1.05f;
-                float diff = (bPos->pos.x + bSize->w / 2.0f) - (pPos->pos.x + pSize->w / 2.0f);
-                bVel->vel.x = diff * 5.0f;
-            }
-        }
+        health->value -= damagePerSecond * hits.size() * dt;  // Cada enemy en contacto suma
+        if (health->value <= 0) health->value = 0;
     }
 }
 
-void systemBallBlockCollision(ECS& ecs) {
-    std::vector<Entity> toRemove;
 
-    for (auto& [ballEnt, _] : ecs.getComponentMap<Ball>()) {
-        auto* bPos = ecs.getComponent<Position>(ballEnt);
-        auto* bVel = ecs.getComponent<Velocity>(ballEnt);
-        auto* bSize = ecs.getComponent<Size>(ballEnt);
-        if (!bPos || !bVel || !bSize) continue;
+Vector2 interpolatedPosition(const Position& pos, float alpha) {
+    if (!pos.hasPrev) return pos.pos;
+    return {pos.prev.x + (pos.pos.x - pos.prev.x) * alpha, pos.prev.y + (pos.pos.y - pos.prev.y) * alpha};
+}
 
-        for (auto& [blockEnt, _] : ecs.getComponentMap<Block>()) {
-            auto* blkPos = ecs.getComponent<Position>(blockEnt);
-            auto* blkSize = ecs.getComponent<Size>(blockEnt);
-            if (!blkPos || !blkSize) continue;
+Camera2D interpolatedCamera(const CameraComp& camComp, float alpha) {
+    Camera2D cam = camComp.cam;
+    cam.target.x = camComp.prevTarget.x + (camComp.cam.target.x - camComp.prevTarget.x) * alpha;
+    cam.target.y = camComp.prevTarget.y + (camComp.cam.target.y - camComp.prevTarget.y) * alpha;
+    return cam;
+}
 
-            if (checkCollision(*bPos, *bSize, *blkPos, *blkSize)) {
-                bVel->vel.y = -bVel->vel.y;
-                toRemove.push_back(blockEnt);
-                break;
-            }
-        }
+void systemSnapshotPositions(ECS& ecs) {
+    PROFILE_ZONE("systemSnapshotPositions");
+    for (auto& [entity, pos] : ecs.getComponentMap<Position>()) {
+        pos.prev = pos.pos;
+        pos.hasPrev = true;
     }
-
-    for (Entity e : toRemove) {
-        ecs.removeComponent<Block>(e);
-        ecs.removeComponent<Position>(e);
-        ecs.removeComponent<Size>(e);
+    for (auto& [entity, camComp] : ecs.getComponentMap<CameraComp>()) {
+        camComp.prevTarget = camComp.cam.target;
     }
 }
 
 
-void systemRender(ECS& ecs) {
+void systemRender(ECS& ecs, RenderQueue& queue, float alpha) {
+    PROFILE_ZONE("systemRender");
+    CommandBuffer& out = queue.main();
     for (auto& [entity, _] : ecs.getComponentMap<PaddleControlled>()) {
         auto* pos = ecs.getComponent<Position>(entity);
         auto* size = ecs.getComponent<Size>(entity);
-        if (pos && size)
-            DrawRectangle((int)pos->pos.x, (int)pos->pos.y, (int)size->w, (int)size->h, DARKBLUE);
-    }
-
-    for (auto& [entity, _] : ecs.getComponentMap<Ball>()) {
-        auto* pos = ecs.getComponent<Position>(entity);
-        auto* size = ecs.getComponent<Size>(entity);
-        if (pos && size)
-            DrawRectangle((int)pos->pos.x, (int)pos->pos.y, (int)size->w, (int)size->h, BLACK);
-    }
-
-    for (auto& [entity, _] : ecs.getComponentMap<Block>()) {
-        auto* pos = ecs.getComponent<Position>(entity);
-        auto* size = ecs.getComponent<Size>(entity);
-        if (pos && size)
-            DrawRectangle((int)pos->pos.x, (int)pos->pos.y, (int)size->w, (int)size->h, RED);
+        if (!pos || !size) continue;
+        Vector2 p = interpolatedPosition(*pos, alpha);
+        out.rect(RenderLayer::Sprites, {(float)(int)p.x, (float)(int)p.y, (float)(int)size->w, (float)(int)size->h}, DARKBLUE);
     }
 }
 
 
 // systemInput: Limita a left/right anims
 void systemInput(ECS& ecs) {
+    PROFILE_ZONE("systemInput");
     for (auto& [entity, _] : ecs.getComponentMap<InputControlled>()) {
         auto* vel = ecs.getComponent<Velocity>(entity);
         auto* anim = ecs.getComponent<Animation>(entity);
         if (!vel || !anim) continue;
 
         vel->vel = {0, 0};
-        if (IsKeyDown(KEY_RIGHT)) vel->vel.x = 200.0f;
-        if (IsKeyDown(KEY_LEFT)) vel->vel.x = -200.0f;
-        if (IsKeyDown(KEY_DOWN)) vel->vel.y = 200.0f;
-        if (IsKeyDown(KEY_UP)) vel->vel.y = -200.0f;
+        if (inputKeyDown(KEY_RIGHT)) vel->vel.x = 200.0f;
+        if (inputKeyDown(KEY_LEFT)) vel->vel.x = -200.0f;
+        if (inputKeyDown(KEY_DOWN)) vel->vel.y = 200.0f;
+        if (inputKeyDown(KEY_UP)) vel->vel.y = -200.0f;
 
         // Set estado: Solo anima left/right; up/down puro va a idle
-        if (vel->vel.x > 0) anim->currentState = "walk_right";
-        else if (vel->vel.x < 0) anim->currentState = "walk_left";
-        else anim->currentState = "idle";  // Incluye si solo up/down o parado
+        if (vel->vel.x > 0) anim->currentState = AnimState::WalkRight;
+        else if (vel->vel.x < 0) anim->currentState = AnimState::WalkLeft;
+        else anim->currentState = AnimState::Idle;  // Incluye si solo up/down o parado
     }
 }
 
 
+// Collider para tiles: con Size, caja centrada a la mitad del sprite (pasa por pasillos de 1 tile);
+// sin Size, el punto centro original (8px * scale)
+static Rectangle tileCollider(const Position& pos, const Size* size, const TileMap& tilemap) {
+    if (size) {
+        return {pos.pos.x + size->w / 4.0f, pos.pos.y + size->h / 4.0f, size->w / 2.0f, size->h / 2.0f};
+    }
+    return {pos.pos.x + 8.0f * tilemap.scale, pos.pos.y + 8.0f * tilemap.scale, 0.0f, 0.0f};
+}
+
 void systemMovement(ECS& ecs, float dt) {
+    PROFILE_ZONE("systemMovement");
+    // Buffers reusados entre frames (batch para sweepMany)
+    static std::vector<std::pair<Position*, Velocity*>> movers;
+    static std::vector<SweepBody> bodies;
+    static std::vector<TileSweep> results;
+    movers.clear();
+    bodies.clear();
+
+    // Asume un solo tilemap (como camera/render)
+    TileMap* tilemap = nullptr;
+    for (auto& [mapEnt, tm] : ecs.getComponentMap<TileMap>()) {
+        tilemap = &tm;
+        break;
+    }
+
     for (auto& [entity, pos] : ecs.getComponentMap<Position>()) {
         auto* vel = ecs.getComponent<Velocity>(entity);
         if (!vel) continue;
 
-        Vector2 newPos = { pos.pos.x + vel->vel.x * dt, pos.pos.y + vel->vel.y * dt };
+        Vector2 delta = {vel->vel.x * dt, vel->vel.y * dt};
+        if (!tilemap) {
+            pos.pos.x += delta.x;
+            pos.pos.y += delta.y;
+            continue;
+        }
+        movers.push_back({&pos, vel});
+        bodies.push_back({tileCollider(pos, ecs.getComponent<Size>(entity), *tilemap), delta});
+    }
 
-        bool canMove = true;
-        for (auto& [mapEnt, tilemap] : ecs.getComponentMap<TileMap>()) {
-            int tx = (int)floor((newPos.x + 8.0f * tilemap.scale) / (tilemap.tileSize * tilemap.scale));
-            int ty = (int)floor((newPos.y + 8.0f * tilemap.scale) / (tilemap.tileSize * tilemap.scale));
-            if (tx < 0 || tx >= tilemap.width || ty < 0 || ty >= tilemap.height) {
-                canMove = false;
+    if (!tilemap) return;
+    sweepMany(*tilemap, bodies, results);
+
+    for (size_t i = 0; i < movers.size(); ++i) {
+        auto [pos, vel] = movers[i];
+        // Aplica el offset del collider resuelto al Position
+        pos->pos.x += results[i].pos.x - bodies[i].box.x;
+        pos->pos.y += results[i].pos.y - bodies[i].box.y;
+        // Solo el eje bloqueado se anula -> desliza por el otro
+        if (results[i].hitX) vel->vel.x = 0;
+        if (results[i].hitY) vel->vel.y = 0;
+    }
+}
+
+
+
+// Un paso de MovementPattern para una entidad (compartido por systemAI y el scheduler de AI LOD)
+void updateMovementPattern(ECS& ecs, Entity entity, MovementPattern& pattern, float dt, const FlowField* flow, const TileMap* tilemap) {
+    auto* pos = ecs.getComponent<Position>(entity);
+    auto* vel = ecs.getComponent<Velocity>(entity);
+    auto* anim = ecs.getComponent<Animation>(entity);  // Opcional para estados
+    if (!pos || !vel) return;
+
+    switch (pattern.type) {
+        case MovementType::Tracking: {
+            if (pattern.target == (Entity)-1) break;
+            auto* targetPos = ecs.getComponent<Position>(pattern.target);
+            if (!targetPos) break;
+
+            Vector2 dir = {targetPos->pos.x - pos->pos.x, targetPos->pos.y - pos->pos.y};
+            float dist = normalize2(dir.x, dir.y);  // simdmath.h: igual que el kernel de AIBatch
+            const TrackingParams& tracking = pattern.tracking;
+            if (tracking.pursuitDistance > 0 && dist > tracking.pursuitDistance) {
+                vel->vel = {0, 0};  // Detener si lejos
+                if (anim) anim->currentState = AnimState::Idle;
                 break;
             }
 
-            int index = ty * tilemap.width + tx;
-            if (tilemap.tiles[index].value == IntGridValue::NON_WALKABLE) {
-                canMove = false;
-                break;
+            // Rodea muros siguiendo el flow field (sample O(1) de la celda del enemy)
+            if (flow) {
+                auto* size = ecs.getComponent<Size>(entity);
+                Vector2 center = size ? Vector2{pos->pos.x + size->w / 2.0f, pos->pos.y + size->h / 2.0f}
+                                      : Vector2{pos->pos.x + 8.0f * tilemap->scale, pos->pos.y + 8.0f * tilemap->scale};
+                Vector2 flowDir;
+                if (flow->sample(center, flowDir)) dir = flowDir;
             }
-        }
 
-        if (canMove) {
-            pos.pos = newPos;
-        } else {
-            vel->vel = {0, 0};  // Stop
-        }
+            Vector2 desiredVel = {dir.x * pattern.speed, dir.y * pattern.speed};
+            vel->vel = Vector2Lerp(vel->vel, desiredVel, tracking.lerpFactor);  // Suavizado
 
-    }
-}
+            if (anim) {
+                if (fabs(vel->vel.x) > fabs(vel->vel.y)) {
+                    anim->currentState = (vel->vel.x > 0) ? AnimState::WalkRight : AnimState::WalkLeft;
+                } else {
+                    anim->currentState = AnimState::Idle;  // O añade up/down si expandes anims
+                }
+            }
+            break;
+        }
 
+        case MovementType::Circular: {
+            CircularParams& circular = pattern.circular;
+            Vector2 effectiveCenter = circular.center;
+            if (pattern.aroundTarget && pattern.target != (Entity)-1) {
+                auto* targetPos = ecs.getComponent<Position>(pattern.target);
+                if (targetPos) effectiveCenter = targetPos->pos;
+            }
 
+            // Ángulo acotado a [0, 2π) y sincos de simdmath.h: mismo resultado que el kernel de AIBatch
+            circular.currentAngle = wrapTwoPi(circular.currentAngle + circular.angularSpeed * dt);
+            float s, c;
+            sinCosApprox(circular.currentAngle, s, c);
+            pos->pos.x = effectiveCenter.x + circular.radius * c;
+            pos->pos.y = effectiveCenter.y + circular.radius * s;
 
-void systemAI(ECS& ecs, float dt) {
-    // Código existente para viejo AIPatrol (si lo mantienes, migra aquí o remueve)
+            // Set vel approx para anim (opcional)
+            vel->vel = { -circular.radius * circular.angularSpeed * s, circular.radius * circular.angularSpeed * c };
 
-    for (auto& [entity, pattern] : ecs.getComponentMap<MovementPattern>()) {
-        auto* pos = ecs.getComponent<Position>(entity);
-        auto* vel = ecs.getComponent<Velocity>(entity);
-        auto* anim = ecs.getComponent<Animation>(entity);  // Opcional para estados
-        if (!pos || !vel) continue;
+            if (anim) anim->currentState = AnimState::Idle;  // O añade "float" anim si quieres
+            break;
+        }
 
-        switch (pattern.type) {
-            case MovementType::Tracking: {
-                if (pattern.target == (Entity)-1) break;
-                auto* targetPos = ecs.getComponent<Position>(pattern.target);
-                if (!targetPos) break;
+        case MovementType::Patrol: {
+            PatrolParams& patrol = pattern.patrol;
+            if (patrol.count == 0) break;
 
-                Vector2 dir = {targetPos->pos.x - pos->pos.x, targetPos->pos.y - pos->pos.y};
-                float dist = Vector2Length(dir);
-                if (pattern.pursuitDistance > 0 && dist > pattern.pursuitDistance) {
-                    vel->vel = {0, 0};  // Detener si lejos
-                    if (anim) anim->currentState = "idle";
+            Vector2 dir = {patrol.waypoint.x - pos->pos.x, patrol.waypoint.y - pos->pos.y};
+            float dist = normalize2(dir.x, dir.y);
+            if (dist < patrol.arrivalThreshold) {
+                // Único acceso a la ruta (cold): al llegar
+                if (!advancePatrol(patrol, ecs.getComponent<PatrolRoute>(entity))) {
+                    vel->vel = {0, 0};  // Stop si no loop
                     break;
                 }
+            }
 
-                if (dist > 0) dir = Vector2Normalize(dir);
-                Vector2 desiredVel = {dir.x * pattern.speed, dir.y * pattern.speed};
-                vel->vel = Vector2Lerp(vel->vel, desiredVel, pattern.lerpFactor);  // Suavizado
+            vel->vel = {dir.x * pattern.speed, dir.y * pattern.speed};
 
-                if (anim) {
-                    if (fabs(vel->vel.x) > fabs(vel->vel.y)) {
-                        anim->currentState = (vel->vel.x > 0) ? "walk_right" : "walk_left";
-                    } else {
-                        anim->currentState = "idle";  // O añade up/down si expandes anims
-                    }
-                }
-                break;
+            if (anim) {
+                anim->currentState = (vel->vel.x > 0) ? AnimState::WalkRight : AnimState::WalkLeft;  // Simple
             }
+            break;
+        }
 
-            case MovementType::Circular: {
-                Vector2 effectiveCenter = pattern.center;
-                if (pattern.aroundTarget && pattern.target != (Entity)-1) {
-                    auto* targetPos = ecs.getComponent<Position>(pattern.target);
-                    if (targetPos) effectiveCenter = targetPos->pos;
-                }
+        default: break;
+    }
+}
 
-                pattern.currentAngle += pattern.angularSpeed * dt;
-                pos->pos.x = effectiveCenter.x + pattern.radius * cosf(pattern.currentAngle);
-                pos->pos.y = effectiveCenter.y + pattern.radius * sinf(pattern.currentAngle);
+void syncPatrolRoute(MovementPattern& pattern, const PatrolRoute& route) {
+    if (pattern.type != MovementType::Patrol) return;
+    PatrolParams& patrol = pattern.patrol;
+    size_t count = route.points.size();
+    if (count > UINT16_MAX) {
+        std::cerr << "Warning: PatrolRoute de " << count << " puntos, se usan los primeros " << UINT16_MAX << std::endl;
+        count = UINT16_MAX;
+    }
+    patrol.count = (uint16_t)count;
+    if (patrol.current >= patrol.count) patrol.current = 0;
+    patrol.waypoint = count > 0 ? route.points[patrol.current] : Vector2{0, 0};
+}
 
-                // Set vel approx para anim (opcional)
-                vel->vel = { -pattern.radius * pattern.angularSpeed * sinf(pattern.currentAngle),
-                             pattern.radius * pattern.angularSpeed * cosf(pattern.currentAngle) };
+bool advancePatrol(PatrolParams& patrol, const PatrolRoute* route) {
+    if (!route || route->points.size() < patrol.count) {  // Ruta removida/achicada sin sync: quieto
+        patrol.count = 0;
+        return false;
+    }
+    patrol.current = (uint16_t)((patrol.current + 1) % patrol.count);
+    patrol.waypoint = route->points[patrol.current];
+    return route->loop || patrol.current != 0;
+}
 
-                if (anim) anim->currentState = "idle";  // O añade "float" anim si quieres
-                break;
-            }
+void systemAI(ECS& ecs, float dt, const FlowField* flow, AIBatch* batch) {
+    PROFILE_ZONE("systemAI");
+    // Código existente para viejo AIPatrol (si lo mantienes, migra aquí o remueve)
 
-            case MovementType::Patrol: {
-                if (pattern.waypoints.empty()) break;
-
-                Vector2 target = pattern.waypoints[pattern.currentWaypoint];
-                Vector2 dir = {target.x - pos->pos.x, target.y - pos->pos.y};
-                float dist = Vector2Length(dir);
-                if (dist < pattern.arrivalThreshold) {
-                    pattern.currentWaypoint = (pattern.currentWaypoint + 1) % pattern.waypoints.size();
-                    if (!pattern.loop && pattern.currentWaypoint == 0) {
-                        vel->vel = {0, 0};  // Stop si no loop
-                        break;
-                    }
-                }
+    // Flow field solo si corresponde al tilemap actual (tras expansión puede ir 1-2 frames atrasado)
+    const TileMap* tilemap = nullptr;
+    for (auto& [mapEnt, tm] : ecs.getComponentMap<TileMap>()) {
+        tilemap = &tm;
+        break;
+    }
+    if (flow && (!tilemap || !flow->matches(*tilemap))) flow = nullptr;
 
-                if (dist > 0) dir = Vector2Normalize(dir);
-                vel->vel = {dir.x * pattern.speed, dir.y * pattern.speed};
+    // Nuevo: particionado por tipo + kernels SIMD; sin batch, una entity a la vez en orden del map
+    if (batch) {
+        batch->update(ecs, dt, flow, tilemap);
+        return;
+    }
+    for (auto& [entity, pattern] : ecs.getComponentMap<MovementPattern>()) {
+        updateMovementPattern(ecs, entity, pattern, dt, flow, tilemap);
+    }
+}
 
-                if (anim) {
-                    anim->currentState = (vel->vel.x > 0) ? "walk_right" : "walk_left";  // Simple
-                }
-                break;
-            }
 
-            default: break;
+bool buildPatrolRoute(ChunkPathfinder& paths, const std::vector<Vector2>& stops, Vector2 centerOffset, WaypointList& out) {
+    static thread_local std::vector<Vector2> leg;  // thread_local: también corre en la carga de escenas (worker)
+    static thread_local std::vector<Vector2> snapped;
+    out.clear();
+    snapped.clear();
+    if (stops.size() < 2) return false;
+
+    // Paradas al tile caminable más cercano (en coords de centro del body)
+    for (auto& stop : stops) {
+        Vector2 c;
+        if (!paths.nearestWalkable({stop.x + centerOffset.x, stop.y + centerOffset.y}, 4, c)) return false;
+        snapped.push_back(c);
+    }
+
+    // Tramos stop[i] -> stop[i+1], cerrando el ciclo para loop
+    for (size_t i = 0; i < snapped.size(); ++i) {
+        if (!paths.findPath(snapped[i], snapped[(i + 1) % snapped.size()], leg)) return false;
+        for (auto& wp : leg) {
+            Vector2 p = {wp.x - centerOffset.x, wp.y - centerOffset.y};  // Waypoints en coords de Position
+            if (!out.empty() && out.back().x == p.x && out.back().y == p.y) continue;
+            out.push_back(p);
         }
     }
+    return out.size() >= 2;
 }
 
+// Random MovementPattern (de los 3 previos), asignado in place. Solo Patrol lleva PatrolRoute: del stock del
+// pool si hay (conserva su bloque del arena), si no una nueva
+static void initEnemyPattern(ECS& ecs, Entity enemy, Vector2 pos, Entity playerTarget, Vector2 centerOffset, ChunkPathfinder* paths, EnemyPool* pool) {
+    MovementPattern& pat = *ecs.getComponent<MovementPattern>(enemy);
+    pat = MovementPattern{};
 
-// Helper para crear enemy template (reuse logic de AdventureScene)
-Entity createEnemy(ECS& ecs, Vector2 pos, Color tint, const Sprite& baseSprite, const Animation& baseAnim, Entity playerTarget) {
-    Entity enemy = ecs.createEntity();
-    ecs.addComponent(enemy, Position{pos});
-    ecs.addComponent(enemy, Velocity{{0, 0}});
-    Sprite spr = baseSprite;
-    spr.tint = tint;
-    ecs.addComponent(enemy, spr);
-    ecs.addComponent(enemy, baseAnim);
-
-    // Random MovementPattern (de los 3 previos)
-    MovementPattern pat;
-    int randType = GetRandomValue(0, 2);
+    int randType = randomValue(0, 2);
     if (randType == 0) {  // Tracking
-        pat.type = MovementType::Tracking;
+        pat.setTracking();
+        pat.tracking.pursuitDistance = 400.0f;
+        pat.tracking.lerpFactor = 0.05f;
         pat.target = playerTarget;
         pat.speed = 150.0f;
-        pat.pursuitDistance = 400.0f;
-        pat.lerpFactor = 0.05f;
     } else if (randType == 1) {  // Circular (fixed center random cerca)
-        pat.type = MovementType::Circular;
-        pat.center = {pos.x + GetRandomValue(-100, 100), pos.y + GetRandomValue(-100, 100)};
-        pat.radius = 150.0f;
-        pat.angularSpeed = 1.5f;
-        pat.currentAngle = 0.0f;
-        pat.aroundTarget = false;
+        pat.setCircular();
+        pat.circular.center = {pos.x + randomValue(-100, 100), pos.y + randomValue(-100, 100)};
+        pat.circular.radius = 150.0f;
+        pat.circular.angularSpeed = 1.5f;
     } else {  // Patrol (3 waypoints random alrededor)
-        pat.type = MovementType::Patrol;
-        pat.waypoints = {
-            pos,
-            {pos.x + GetRandomValue(50, 200), pos.y + GetRandomValue(50, 200)},
-            {pos.x + GetRandomValue(-200, -50), pos.y + GetRandomValue(-200, -50)}
-        };
+        static thread_local std::vector<Vector2> stops;  // Como leg/snapped: spawns en la carga (worker) y en el main thread
+        stops.clear();
+        stops.push_back(pos);
+        stops.push_back({pos.x + randomValue(50, 200), pos.y + randomValue(50, 200)});
+        stops.push_back({pos.x + randomValue(-200, -50), pos.y + randomValue(-200, -50)});
+        pat.setPatrol();
+        pat.patrol.arrivalThreshold = 10.0f;
         pat.speed = 120.0f;
-        pat.loop = true;
-        pat.arrivalThreshold = 10.0f;
+
+        PatrolRoute* route = ecs.getComponent<PatrolRoute>(enemy);
+        if (!route) {
+            if (pool) route = &pool->attachRoute(ecs, enemy);
+            else {
+                ecs.addComponent(enemy, PatrolRoute{});
+                route = ecs.getComponent<PatrolRoute>(enemy);
+            }
+        }
+        route->points.clear();
+        route->loop = true;
+
+        // Con pathfinder: misma patrulla pero rodeando muros (ruta multi-chunk)
+        if (!paths || !buildPatrolRoute(*paths, stops, centerOffset, route->points)) {
+            route->points.assign(stops.data(), stops.data() + stops.size());
+        }
+        syncPatrolRoute(pat, *route);
     }
-    ecs.addComponent(enemy, pat);
+}
+
+bool validEnemyPrefab(const Prefab& enemy) {
+    return enemy.get<Position>() && enemy.get<Velocity>() && enemy.get<Size>() && enemy.get<Sprite>() &&
+           enemy.get<Animation>() && enemy.get<MovementPattern>() && enemy.get<SpawnedBy>();
+}
+
+// Reusa una entity del pool: mismos components (los del prefab), valores de vuelta a los del prefab (sin copiar Animation)
+static void resetEnemy(ECS& ecs, Entity enemy, const Prefab& prefab) {
+    ecs.getComponent<Position>(enemy)->hasPrev = false;  // Teletransporte: no interpolar desde donde se despawneó
+    ecs.getComponent<Velocity>(enemy)->vel = {0, 0};
+    *ecs.getComponent<Sprite>(enemy) = *prefab.get<Sprite>();
+    *ecs.getComponent<Size>(enemy) = *prefab.get<Size>();
+    Animation* anim = ecs.getComponent<Animation>(enemy);
+    anim->currentState = AnimState::Idle;
+    anim->currentFrame = 0;
+    anim->timer = 0.0f;
+}
 
-    return enemy;
+// Por spawn (instanciado o reciclado): posición, tint, spawner y pattern random
+static void initSpawnedEnemy(ECS& ecs, Entity enemy, Vector2 pos, Entity spawner, Entity playerTarget, ChunkPathfinder* paths, EnemyPool* pool) {
+    ecs.getComponent<Position>(enemy)->pos = pos;
+    ecs.getComponent<Sprite>(enemy)->tint = {(unsigned char)randomValue(100, 255), (unsigned char)randomValue(100, 255), (unsigned char)randomValue(100, 255), 255};
+    ecs.getComponent<SpawnedBy>(enemy)->spawner = spawner;
+    const Size* size = ecs.getComponent<Size>(enemy);
+    initEnemyPattern(ecs, enemy, pos, playerTarget, {size->w / 2.0f, size->h / 2.0f}, paths, pool);
 }
 
-void systemEnemySpawn(ECS& ecs, float dt) {
+void systemEnemySpawn(ECS& ecs, float dt, const Prefab& enemy, ChunkPathfinder* paths, EnemyPool* pool) {
+    PROFILE_ZONE("systemEnemySpawn");
+    if (!validEnemyPrefab(enemy)) {
+        std::cerr << "Error: prefab '" << enemy.name << "' sin los components de un enemy spawneado" << std::endl;
+        return;
+    }
     Entity player = (Entity)-1;
     for (auto& [ent, _] : ecs.getComponentMap<InputControlled>()) {
         player = ent;
@@ -340,10 +440,23 @@ void systemEnemySpawn(ECS& ecs, float dt) {
     }
 
 
-    // Template para enemies (reuse de player, ajusta si tienes assets específicos)
-    auto* baseSprite = ecs.getComponent<Sprite>(player);  // Reuse mago
-    auto* baseAnim = ecs.getComponent<Animation>(player);
-    if (!baseSprite || !baseAnim) return;
+    // Despawn: enemies lejos del player vuelven al pool (o se destruyen sin pool)
+    static std::vector<Entity> toDespawn;
+    toDespawn.clear();
+    toDespawn.reserve(ecs.getComponentMap<SpawnedBy>().size());  // Realloc solo con más vivos que nunca
+    for (auto& [ent, spawned] : ecs.getComponentMap<SpawnedBy>()) {
+        auto* spawner = ecs.getComponent<EnemySpawner>(spawned.spawner);
+        auto* pos = ecs.getComponent<Position>(ent);
+        if (!spawner || !pos || spawner->despawnDistance <= 0) continue;
+        if (Vector2DistanceSqr(pos->pos, playerPos->pos) > spawner->despawnDistance * spawner->despawnDistance) {
+            toDespawn.push_back(ent);
+        }
+    }
+    for (Entity e : toDespawn) {
+        if (auto* spawner = ecs.getComponent<EnemySpawner>(ecs.getComponent<SpawnedBy>(e)->spawner)) spawner->alive--;
+        if (pool) pool->release(ecs, e);
+        else ecs.removeEntity(e);
+    }
 
     for (auto& [ent, spawner] : ecs.getComponentMap<EnemySpawner>()) {
         float distToPlayer = Vector2Distance(spawner.center, playerPos->pos);
@@ -351,8 +464,17 @@ void systemEnemySpawn(ECS& ecs, float dt) {
 
         spawner.timer += dt;
         if (spawner.timer >= spawner.frequency) {
-            int num = GetRandomValue(spawner.minEnemies, spawner.maxEnemies);
-            std::vector<Vector2> positions;
+            int num = randomValue(spawner.minEnemies, spawner.maxEnemies);
+            // Caps: por spawner y global (pool)
+            num = std::min(num, spawner.maxAlive - spawner.alive);
+            if (pool) num = std::min(num, pool->maxLive - pool->getLive());
+            if (num <= 0) {
+                spawner.timer = 0.0f;  // Wave saltada; reintenta en el próximo ciclo
+                continue;
+            }
+            static std::vector<Vector2> positions;  // Reusado entre waves
+            positions.clear();
+            positions.reserve(std::max(num, spawner.maxEnemies));  // Una vez por tamaño máximo de wave
 
             switch (spawner.type) {
                 case SpawnType::LineHorizontal:
@@ -382,67 +504,62 @@ void systemEnemySpawn(ECS& ecs, float dt) {
                 case SpawnType::RandomArea: {
                     Vector2 halfSize = {spawner.areaSize.x / 2.0f, spawner.areaSize.y / 2.0f};
                     for (int i = 0; i < num; ++i) {
-                        Vector2 pos = {spawner.center.x + GetRandomValue(-halfSize.x, halfSize.x),
-                                       spawner.center.y + GetRandomValue(-halfSize.y, halfSize.y)};
+                        Vector2 pos = {spawner.center.x + randomValue(-halfSize.x, halfSize.x),
+                                       spawner.center.y + randomValue(-halfSize.y, halfSize.y)};
                         positions.push_back(pos);
                     }
                     break;
                 }
             }
 
-            // Spawnea enemies en positions, con tint random para variedad
-            for (auto& p : positions) {
-                Color tint = { (unsigned char)GetRandomValue(100, 255), (unsigned char)GetRandomValue(100, 255), (unsigned char)GetRandomValue(100, 255), 255 };
-                Entity newEnemy = createEnemy(ecs, p, tint, *baseSprite, *baseAnim, player);
-                std::cout << ("  - Spawned enemy ", newEnemy, " at ", p.x, ",", p.y ) << std::endl;
+            // Con pathfinder: mueve cada spawn fuera de muros (tile caminable más cercano)
+            if (paths) {
+                const Size* size = enemy.get<Size>();
+                Vector2 half = {size->w / 2.0f, size->h / 2.0f};
+                for (auto& p : positions) {
+                    Vector2 c;
+                    if (paths->nearestWalkable({p.x + half.x, p.y + half.y}, 3, c)) p = {c.x - half.x, c.y - half.y};
+                }
+            }
+
+            // Spawnea enemies en positions, con tint random para variedad: primero los del pool, el resto en batch
+            const size_t recycled = pool ? std::min(positions.size(), pool->getParked()) : 0;
+            for (size_t i = 0; i < recycled; ++i) {
+                Entity e = pool->acquire(ecs);
+                resetEnemy(ecs, e, enemy);
+                initSpawnedEnemy(ecs, e, positions[i], ent, player, paths, pool);
+            }
+            if (recycled < positions.size()) {
+                ecs.instantiate(enemy, positions.size() - recycled, [&](Entity e, size_t i) {
+                    initSpawnedEnemy(ecs, e, positions[recycled + i], ent, player, paths, pool);
+                    if (pool) pool->noteCreated();
+                });
             }
+            spawner.alive += (int)positions.size();
 
             spawner.timer = 0.0f;  // Reset
         }
     }
 }
 
-void systemDebugSpawners(ECS& ecs) {
-    for (auto& [ent, spawner] : ecs.getComponentMap<EnemySpawner>()) {
-        Color color = YELLOW;  // Semi-transparente
-        color.a = 128;
-
-        switch (spawner.type) {
-            case SpawnType::LineHorizontal:
-                DrawLineEx({spawner.center.x - (spawner.maxEnemies * spawner.spacing / 2.0f), spawner.center.y},
-                           {spawner.center.x + (spawner.maxEnemies * spawner.spacing / 2.0f), spawner.center.y},
-                           2.0f, color);
-                break;
-            case SpawnType::LineVertical:
-                DrawLineEx({spawner.center.x, spawner.center.y - (spawner.maxEnemies * spawner.spacing / 2.0f)},
-                           {spawner.center.x, spawner.center.y + (spawner.maxEnemies * spawner.spacing / 2.0f)},
-                           2.0f, color);
-                break;
-            case SpawnType::Circular:
-                DrawCircleLines(spawner.center.x, spawner.center.y, spawner.radius, color);
-                break;
-            case SpawnType::RandomArea:
-                DrawRectangleLinesEx({spawner.center.x - spawner.areaSize.x / 2.0f, spawner.center.y - spawner.areaSize.y / 2.0f,
-                                      spawner.areaSize.x, spawner.areaSize.y}, 2.0f, color);
-                break;
-        }
-        // Draw center point
-        DrawCircle(spawner.center.x, spawner.center.y, 5.0f, RED);
-    }
+void systemDebugSpawners(ECS& ecs, SpawnerOverlay& overlay, RenderQueue& queue, Rectangle view) {
+    PROFILE_ZONE("systemDebugSpawners");
+    overlay.submit(ecs, queue.main(), view);
 }
 
 
 
 
 void systemAnimationUpdate(ECS& ecs, float dt) {
+    PROFILE_ZONE("systemAnimationUpdate");
     for (auto& [entity, anim] : ecs.getComponentMap<Animation>()) {
         auto* sprite = ecs.getComponent<Sprite>(entity);
         if (!sprite) continue;
 
-        std::string state = anim.currentState;
+        const int state = (int)anim.currentState;
+        if (state >= kAnimStateCount) continue;
         if (anim.mode == AnimationMode::Sheet) {
-            if (anim.rectStates.find(state) == anim.rectStates.end()) continue;
-            auto& frames = anim.rectStates[state];
+            auto& frames = anim.rectStates[state];  // Sin lookup por nombre
             if (frames.empty()) continue;
             anim.timer += dt;
             if (anim.timer >= anim.frameTime) {
@@ -451,7 +568,6 @@ void systemAnimationUpdate(ECS& ecs, float dt) {
                 anim.timer = 0.0f;
             }
         } else {  // Separate
-            if (anim.texStates.find(state) == anim.texStates.end()) continue;
             auto& frames = anim.texStates[state];
             if (frames.empty()) continue;
             anim.timer += dt;
@@ -465,27 +581,58 @@ void systemAnimationUpdate(ECS& ecs, float dt) {
 }
 
 
-void systemRenderSprites(ECS& ecs) {
-    for (auto& [entity, sprite] : ecs.getComponentMap<Sprite>()) {
-        auto* pos = ecs.getComponent<Position>(entity);
-        if (!pos) continue;
-        
-        Vector2 drawPos = {pos->pos.x - sprite.origin.x * sprite.scale.x, 
-                           pos->pos.y - sprite.origin.y * sprite.scale.y};
-        
-        if (sprite.isSheet) {
-            Rectangle destRec = {drawPos.x, drawPos.y, 
-                                 sprite.frameRec.width * sprite.scale.x, 
-                                 sprite.frameRec.height * sprite.scale.y};
-            DrawTexturePro(sprite.texture, sprite.frameRec, destRec, {0,0}, 0.0f, sprite.tint);
-        } else {
-            Rectangle destRec = {drawPos.x, drawPos.y, 
-                                 (float)sprite.texture.width * sprite.scale.x, 
-                                 (float)sprite.texture.height * sprite.scale.y};
-            Rectangle srcRec = {0, 0, (float)sprite.texture.width, (float)sprite.texture.height};
-            DrawTexturePro(sprite.texture, srcRec, destRec, {0,0}, 0.0f, sprite.tint);
+static void submitSprite(CommandBuffer& out, const Sprite& sprite, Rectangle destRec) {
+    Rectangle srcRec = spriteSourceRect(sprite);
+    out.quad(RenderLayer::Sprites, sprite.texture, srcRec, destRec, sprite.tint, depthFromY(destRec.y + destRec.height));  // Y-sort por los pies
+}
+
+void systemRenderSprites(ECS& ecs, RenderQueue& queue, float alpha, SpriteCuller* culler) {
+    PROFILE_ZONE("systemRenderSprites");
+    CameraComp* camComp = nullptr;
+    if (culler) {
+        for (auto& [camEnt, comp] : ecs.getComponentMap<CameraComp>()) {
+            camComp = &comp;
+            break;
         }
     }
+
+    if (!camComp) {  // Sin culling: todo el mundo
+        CommandBuffer& out = queue.main();
+        for (auto& [entity, sprite] : ecs.getComponentMap<Sprite>()) {
+            auto* pos = ecs.getComponent<Position>(entity);
+            if (!pos) continue;
+            submitSprite(out, sprite, spriteBounds(sprite, interpolatedPosition(*pos, alpha)));
+        }
+        return;
+    }
+
+    // Candidatos del grid (vista + margen) y test exacto con la posición interpolada. Los rangos se generan
+    // en paralelo, cada uno en su CommandBuffer: los maps se resuelven antes (getComponentMap puede crear storage)
+    const Rectangle view = cameraViewRect(interpolatedCamera(*camComp, alpha));
+    const std::vector<Entity>& candidates = culler->query(ecs, view);
+    const auto& sprites = ecs.getComponentMap<Sprite>();
+    const auto& positions = ecs.getComponentMap<Position>();
+    std::atomic<int> drawn{0};
+    queue.parallelFor(candidates.size(), 2048, [&](CommandBuffer& out, size_t begin, size_t end) {
+        int rangeDrawn = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const Entity entity = candidates[i];
+            auto sprite = sprites.find(entity);
+            auto pos = positions.find(entity);
+            if (sprite == sprites.end() || pos == positions.end()) continue;
+            Rectangle dest = spriteBounds(sprite->second, interpolatedPosition(pos->second, alpha));
+            if (dest.x > view.x + view.width || dest.x + dest.width < view.x ||
+                dest.y > view.y + view.height || dest.y + dest.height < view.y) continue;
+            submitSprite(out, sprite->second, dest);
+            ++rangeDrawn;
+        }
+        drawn += rangeDrawn;
+    });
+    CullStats& stats = culler->stats;
+    stats.total = (int)sprites.size();
+    stats.candidates = (int)candidates.size();
+    stats.drawn = drawn;
+    stats.culled = stats.total - stats.drawn;
 }
 
 
@@ -564,6 +711,7 @@ std::map<uint8_t, std::pair<int, int>> d_corner = {
 
 
 void systemAutoTiling(ECS& ecs) {
+    PROFILE_ZONE("systemAutoTiling");
     for (auto& [entity, tilemap] : ecs.getComponentMap<TileMap>()) {
         if (tilemap.tiles.size() != tilemap.width * tilemap.height) continue;
 
@@ -581,17 +729,19 @@ void systemAutoTiling(ECS& ecs) {
                     continue;
                 } else if (tile.value == IntGridValue::NON_WALKABLE) {
                     tile.specialTex = tilemap.wallTex;  // Optional: Si quieres specials para walls, sino set {0}
-                    if (tile.specialTex.id != 0) continue;  // Skip bitmask si special
+                    if (textureLoaded(tile.specialTex)) continue;  // Skip bitmask si special
                 }
 
                 if (tile.value == IntGridValue::WALKABLE) {
-                    std::vector<std::pair<int, int>> groundVariants = {
+                    static const std::pair<int, int> groundVariants[4] = {
                         {0, 0}, {16, 0}, {0, 16}, {16, 16}
                     };
-                    int randIdx = GetRandomValue(0, groundVariants.size() - 1);
+                    int randIdx = randomValue(0, 3);
                     tile.frame.x = static_cast<float>(groundVariants[randIdx].first);
                     tile.frame.y = static_cast<float>(groundVariants[randIdx].second);
+#ifdef DEBUG
                     std::cout << "Walkable frame: (" << tile.frame.x << "," << tile.frame.y << ")" << std::endl;  // Debug qué pickea
+#endif
                     continue;
                 }
 
@@ -642,7 +792,7 @@ void systemAutoTiling(ECS& ecs) {
                     std::cerr << "Bitmask not found: " << static_cast<int>(bitmask) << std::endl;
                 } else {
                     auto& variants = it->second;
-                    int randIdx = GetRandomValue(0, variants.size() - 1);
+                    int randIdx = randomValue(0, variants.size() - 1);
                     tile.frame.x = static_cast<float>(variants[randIdx].first);
                     tile.frame.y = static_cast<float>(variants[randIdx].second);
                 }
@@ -653,7 +803,21 @@ void systemAutoTiling(ECS& ecs) {
 
 
 
-void systemRenderTileMap(ECS& ecs) {
+Rectangle tileSource(const TileMap& tilemap, const Tile& tile, Texture2D& texture) {
+    if (textureLoaded(tile.specialTex)) {  // Prioridad: special (sub-rect según el tipo, mismo mapeo que el autotiling)
+        texture = tile.specialTex;
+        const Rectangle& src = tile.value == IntGridValue::HAZARD ? tilemap.hazardSrc
+                             : tile.value == IntGridValue::PICKUP ? tilemap.pickupSrc : tilemap.wallSrc;
+        if (src.width > 0) return src;
+        return {0, 0, (float)tile.specialTex.width, (float)tile.specialTex.height};  // Textura suelta: completa
+    }
+    texture = tilemap.tileset;  // Fallback a tileset sub-rect
+    return {tilemap.tilesetOrigin.x + tile.frame.x, tilemap.tilesetOrigin.y + tile.frame.y,
+            (float)tilemap.tileSize, (float)tilemap.tileSize};
+}
+
+void systemRenderTileMap(ECS& ecs, RenderQueue& queue, ChunkSummaries* summaries) {
+    PROFILE_ZONE("systemRenderTileMap");
     for (auto& [entity, tilemap] : ecs.getComponentMap<TileMap>()) {
         // Get camera para culling (asumiendo una—itera si multi)
         CameraComp* camComp = nullptr;
@@ -681,33 +845,40 @@ void systemRenderTileMap(ECS& ecs) {
         int startY = std::max(0, (int)floor(camMin.y / scaledTile));
         int endX = std::min(tilemap.width - 1, (int)ceil(camMax.x / scaledTile));
         int endY = std::min(tilemap.height - 1, (int)ceil(camMax.y / scaledTile));
+        if (endX < startX || endY < startY) continue;
+
+        // Alejado: un quad de resumen por chunk visible en vez de un quad por tile
+        if (summaries) {
+            const int level = summaries->levelForZoom(tilemap, camComp->cam.zoom);
+            if (level > 0) {
+                summaries->submit(tilemap, queue.main(), {camMin.x, camMin.y, camMax.x - camMin.x, camMax.y - camMin.y}, level);
+                continue;
+            }
+        }
 
-        for (int y = startY; y <= endY; ++y) {
-            for (int x = startX; x <= endX; ++x) {
-                int index = y * tilemap.width + x;
-                // ... en loop
-                Tile& tile = tilemap.tiles[index];
-
-                Rectangle dest = { x * scaledTile, y * scaledTile, scaledTile, scaledTile };
-
-                if (tile.specialTex.id != 0) {  // Prioridad: Usa separate tex full (no src sub-rect)
-                    Rectangle src = {0, 0, (float)tile.specialTex.width, (float)tile.specialTex.height};  // Full tex
-                    DrawTexturePro(tile.specialTex, src, dest, {0,0}, 0.0f, WHITE);
-                #ifdef DEBUG
-                    std::cout << "Rendering special at (" << x << "," << y << ") with tex ID " << tile.specialTex.id << std::endl;
-                #endif
-                } else {  // Fallback a tileset sub-rect
-                    Rectangle src = { tile.frame.x, tile.frame.y, (float)tilemap.tileSize, (float)tilemap.tileSize };
-                    DrawTexturePro(tilemap.tileset, src, dest, {0,0}, 0.0f, WHITE);
+        // Filas en paralelo (~2048 tiles por rango); el sort agrupa tileset y specials por textura
+        const TileMap& tm = tilemap;
+        const size_t rows = (size_t)(endY - startY + 1);
+        const size_t rowsPerRange = std::max<size_t>(1, 2048 / (size_t)(endX - startX + 1));
+        queue.parallelFor(rows, rowsPerRange, [&, startX, startY, endX](CommandBuffer& out, size_t begin, size_t end) {
+            for (int y = startY + (int)begin; y < startY + (int)end; ++y) {
+                for (int x = startX; x <= endX; ++x) {
+                    const Tile& tile = tm.tiles[y * tm.width + x];
+                    Rectangle dest = { x * scaledTile, y * scaledTile, scaledTile, scaledTile };
+
+                    Texture2D texture;
+                    Rectangle src = tileSource(tm, tile, texture);
+                    out.quad(RenderLayer::Tiles, texture, src, dest, WHITE);
                 }
             }
-        }
+        });
     }
 }
 
 
 
 void systemTileInteractions(ECS& ecs, float dt) {
+    PROFILE_ZONE("systemTileInteractions");
     for (auto& [entity, pos] : ecs.getComponentMap<Position>()) {
         if (!ecs.hasComponent<InputControlled>(entity)) continue;  // Solo player
 
@@ -732,6 +903,7 @@ void systemTileInteractions(ECS& ecs, float dt) {
                 case IntGridValue::PICKUP:
                     score->value += 10;
                     tile.value = IntGridValue::WALKABLE;  // Recolectar
+                    tilemap.revision++;
                     std::cout << "Pickup! Score now: " << score->value << std::endl;  // Debug
                     break;
                 default: break;
@@ -741,36 +913,18 @@ void systemTileInteractions(ECS& ecs, float dt) {
 }
 
 
-void systemDebugIntGrid(ECS& ecs) {
+void systemDebugIntGrid(ECS& ecs, IntGridOverlay& overlay, RenderQueue& queue, Rectangle view) {
+    PROFILE_ZONE("systemDebugIntGrid");
     for (auto& [entity, tilemap] : ecs.getComponentMap<TileMap>()) {
-        for (int y = 0; y < tilemap.height; ++y) {
-            for (int x = 0; x < tilemap.width; ++x) {
-                int index = y * tilemap.width + x;
-                Tile& tile = tilemap.tiles[index];
-
-                Rectangle dest = {
-                    static_cast<float>(x * tilemap.tileSize) * tilemap.scale,
-                    static_cast<float>(y * tilemap.tileSize) * tilemap.scale,
-                    static_cast<float>(tilemap.tileSize) * tilemap.scale,
-                    static_cast<float>(tilemap.tileSize) * tilemap.scale
-                };
-
-                Color color = {0,0,0,0};
-                switch (tile.value) {
-                    case IntGridValue::NON_WALKABLE: color = {255,0,0,128}; break;
-                    case IntGridValue::HAZARD: color = {255,165,0,128}; break;
-                    case IntGridValue::PICKUP: color = {0,255,0,128}; break;
-                    default: continue;
-                }
-                DrawRectangleRec(dest, color);
-            }
-        }
+        overlay.submit(tilemap, queue.main(), view);  // Un overlay = un tilemap (el primero)
+        break;
     }
 }
 
 
 
 void systemCameraUpdate(ECS& ecs, float dt) {
+    PROFILE_ZONE("systemCameraUpdate");
     for (auto& [entity, camComp] : ecs.getComponentMap<CameraComp>()) {
         if (camComp.target == (Entity)-1) continue;
 
@@ -797,7 +951,38 @@ void systemCameraUpdate(ECS& ecs, float dt) {
 }
 
 
+void generateChunkTiles(TileMap& tilemap, int offsetX, int offsetY, PerlinNoise& perlin, const ChunkGenParams& params) {
+    PROFILE_ZONE("generateChunkTiles");
+    const int chunkSize = tilemap.chunkSize;  // Precompute const
+    for (int y = 0; y < chunkSize; ++y) {
+        for (int x = 0; x < chunkSize; ++x) {
+            int globalX = x + offsetX * chunkSize;
+            int globalY = y + offsetY * chunkSize;
+            int localY = y + (offsetY >= 0 ? offsetY * chunkSize : 0);  // Ajuste para negative offsets
+            int localX = x + (offsetX >= 0 ? offsetX * chunkSize : 0);
+            int index = localY * tilemap.width + localX;
+
+            double noiseVal = perlin.noise(globalX * params.frequency, globalY * params.frequency);
+
+            if (noiseVal > params.thresholdWall) {
+                tilemap.tiles[index].value = IntGridValue::NON_WALKABLE;
+            } else if (noiseVal < params.thresholdHazard) {
+                tilemap.tiles[index].value = IntGridValue::HAZARD;
+            } else {
+                tilemap.tiles[index].value = IntGridValue::WALKABLE;
+            }
+
+            // Random pickups en walkable (raro, ~2%)
+            if (tilemap.tiles[index].value == IntGridValue::WALKABLE && randomValue(0, 100) < 2) {
+                tilemap.tiles[index].value = IntGridValue::PICKUP;
+            }
+        }
+    }
+}
+
+
 void systemAutoTilingChunk(ECS& ecs, int startX, int startY, int endX, int endY) {
+    PROFILE_ZONE("systemAutoTilingChunk");
     for (auto& [entity, tilemap] : ecs.getComponentMap<TileMap>()) {
         // Clamp ranges to grid
         startX = std::max(0, startX);
@@ -820,17 +1005,19 @@ void systemAutoTilingChunk(ECS& ecs, int startX, int startY, int endX, int endY)
                     continue;
                 } else if (tile.value == IntGridValue::NON_WALKABLE) {
                     tile.specialTex = tilemap.wallTex;  // Optional: Si quieres specials para walls, sino set {0}
-                    if (tile.specialTex.id != 0) continue;  // Skip bitmask si special
+                    if (textureLoaded(tile.specialTex)) continue;  // Skip bitmask si special
                 }
 
                 if (tile.value == IntGridValue::WALKABLE) {
-                    std::vector<std::pair<int, int>> groundVariants = {
+                    static const std::pair<int, int> groundVariants[4] = {
                         {0, 0}, {16, 0}, {0, 16}, {16, 16}
                     };
-                    int randIdx = GetRandomValue(0, groundVariants.size() - 1);
+                    int randIdx = randomValue(0, 3);
                     tile.frame.x = static_cast<float>(groundVariants[randIdx].first);
                     tile.frame.y = static_cast<float>(groundVariants[randIdx].second);
+#ifdef DEBUG
                     std::cout << "Walkable frame: (" << tile.frame.x << "," << tile.frame.y << ")" << std::endl;  // Debug qué pickea
+#endif
                     continue;
                 }
 
@@ -882,7 +1069,7 @@ void systemAutoTilingChunk(ECS& ecs, int startX, int startY, int endX, int endY)
                     std::cerr << "Bitmask not found: " << static_cast<int>(bitmask) << std::endl;
                 } else {
                     auto& variants = it->second;
-                    int randIdx = GetRandomValue(0, variants.size() - 1);
+                    int randIdx = randomValue(0, variants.size() - 1);
                     tile.frame.x = static_cast<float>(variants[randIdx].first);
                     tile.frame.y = static_cast<float>(variants[randIdx].second);
                 }
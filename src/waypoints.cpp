@@ -0,0 +1,132 @@
+// src/waypoints.cpp
+#include "waypoints.h"
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <bit>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kMinBlock = 16;          // Puntos: el primer tamaño de overflow (kInline * 2)
+constexpr uint32_t kSlabPoints = 4096;      // 32 KB por slab
+constexpr int kClasses = 32;
+
+class WaypointArena {
+public:
+    // Bloque de al menos `n` puntos; devuelve la capacidad real (potencia de 2) en `capacity`
+    Vector2* allocate(uint32_t n, uint32_t& capacity) {
+        capacity = std::max(kMinBlock, std::bit_ceil(n));
+        const int cls = std::countr_zero(capacity);
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.usedBytes += capacity * sizeof(Vector2);
+        stats.blocks++;
+        auto& list = freeLists[cls];
+        if (!list.empty()) {
+            Vector2* block = list.back();
+            list.pop_back();
+            return block;
+        }
+        // Bloques más grandes que un slab van en su propio slab
+        if (capacity > kSlabPoints) return newSlab(capacity);
+        if (slabUsed + capacity > kSlabPoints) {
+            current = newSlab(kSlabPoints);
+            slabUsed = 0;
+        }
+        Vector2* block = current + slabUsed;
+        slabUsed += capacity;
+        return block;
+    }
+
+    void free(Vector2* block, uint32_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.usedBytes -= capacity * sizeof(Vector2);
+        stats.blocks--;
+        freeLists[std::countr_zero(capacity)].push_back(block);
+    }
+
+    WaypointArenaStats getStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Vector2[]>> slabs;
+    Vector2* current = nullptr;
+    uint32_t slabUsed = kSlabPoints;  // Fuerza el primer slab
+    std::vector<Vector2*> freeLists[kClasses];
+    WaypointArenaStats stats;
+
+    Vector2* newSlab(uint32_t points) {
+        slabs.push_back(std::make_unique<Vector2[]>(points));
+        stats.reservedBytes += points * sizeof(Vector2);
+        return slabs.back().get();
+    }
+};
+
+// Nunca se destruye: WaypointLists en objetos estáticos pueden liberar su bloque después de main
+WaypointArena& arena() {
+    static WaypointArena* instance = new WaypointArena();
+    return *instance;
+}
+
+}  // namespace
+
+WaypointList& WaypointList::operator=(WaypointList&& other) noexcept {
+    if (this != &other) {
+        release();
+        steal(other);
+    }
+    return *this;
+}
+
+void WaypointList::steal(WaypointList& other) {
+    count = other.count;
+    if (other.heap) {
+        heap = other.heap;
+        cap = other.cap;
+        other.heap = nullptr;
+        other.cap = kInline;
+    } else {
+        heap = nullptr;
+        cap = kInline;
+        std::memcpy(inlinePoints, other.inlinePoints, count * sizeof(Vector2));
+    }
+    other.count = 0;
+}
+
+void WaypointList::release() {
+    if (heap) arena().free(heap, cap);
+    heap = nullptr;
+    cap = kInline;
+    count = 0;
+}
+
+void WaypointList::reserve(size_t n) {
+    if (n <= cap) return;
+    uint32_t newCap;
+    Vector2* block = arena().allocate((uint32_t)n, newCap);
+    std::memcpy(block, data(), count * sizeof(Vector2));
+    if (heap) arena().free(heap, cap);
+    heap = block;
+    cap = newCap;
+}
+
+void WaypointList::push_back(Vector2 p) {
+    if (count == cap) reserve((size_t)cap * 2);
+    data()[count++] = p;
+}
+
+void WaypointList::assign(const Vector2* first, const Vector2* last) {
+    const size_t n = (size_t)(last - first);
+    count = 0;  // reserve no copia los viejos
+    reserve(n);
+    std::memmove(data(), first, n * sizeof(Vector2));
+    count = (uint32_t)n;
+}
+
+WaypointArenaStats waypointArenaStats() {
+    return arena().getStats();
+}